@@ -1,91 +1,105 @@
 //------------------------------------------------------------------------------
 // File generated by LCD Assistant
 // http://en.radzio.dxp.pl/bitmap_converter/
+//
+// Rearranged to Glyph per ASCII code 0x20(' ') ~ 0x7E('~'), Glyph = chr-0x20
+// Each Glyph is Page ready: 7 Columns of Page 0 (Bit[0:7]), 7 Columns of Page 1 (Bit[8:15])
 //------------------------------------------------------------------------------
 
-const unsigned char Font7x16 [] = {
-0x00, 0xF8, 0x46, 0x22, 0x12, 0x8A, 0x7C, 0x00, 0x04, 0x02, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x04,
-0x82, 0x42, 0x22, 0x1C, 0x00, 0x00, 0x84, 0x12, 0x12, 0x12, 0xEC, 0x00, 0x40, 0x60, 0x50, 0x48,
-0x44, 0xFE, 0x40, 0x00, 0x9E, 0x12, 0x12, 0x12, 0xE2, 0x00, 0x00, 0xF8, 0x24, 0x12, 0x12, 0x12,
-0xE0, 0x00, 0x02, 0x02, 0x82, 0x62, 0x1A, 0x06, 0x00, 0xEC, 0x12, 0x12, 0x12, 0xEC, 0x00, 0x00,
-0x9C, 0x22, 0x22, 0x22, 0x92, 0x7C, 0x00, 0xE0, 0x5C, 0x42, 0x4E, 0x70, 0xC0, 0x00, 0xFE, 0x22,
-0x22, 0x32, 0xEC, 0x00, 0x00, 0x78, 0x84, 0x02, 0x02, 0x84, 0x00, 0x00, 0xFE, 0x02, 0x02, 0x02,
-0x84, 0x78, 0x00, 0xFE, 0x12, 0x12, 0x12, 0x12, 0x00, 0x00, 0xFE, 0x12, 0x12, 0x12, 0x12, 0x00,
-0x78, 0x84, 0x02, 0x22, 0x22, 0xE4, 0x00, 0x00, 0xFE, 0x10, 0x10, 0x10, 0xFE, 0x00, 0x00, 0x02,
-0x02, 0xFE, 0x02, 0x02, 0x00, 0x00, 0x02, 0x02, 0x02, 0xFE, 0x02, 0x00, 0x00, 0xFE, 0x10, 0x18,
-0x24, 0xC2, 0x00, 0x00, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0x04, 0x18, 0x20, 0x18, 0x04,
-0xFE, 0x00, 0xFE, 0x04, 0x38, 0xC0, 0xFE, 0x00, 0x78, 0x84, 0x02, 0x02, 0x02, 0x84, 0x78, 0x00,
-0xFE, 0x22, 0x22, 0x22, 0x1C, 0x00, 0xF8, 0x04, 0x02, 0x42, 0x82, 0x7C, 0x00, 0x00, 0xFE, 0x22,
-0x22, 0x62, 0x9C, 0x00, 0x00, 0x8C, 0x12, 0x12, 0x22, 0xC4, 0x00, 0x00, 0x02, 0x02, 0xFE, 0x02,
-0x02, 0x00, 0x00, 0xFE, 0x00, 0x00, 0x00, 0x00, 0xFE, 0x00, 0x3E, 0xE0, 0x00, 0xE0, 0x38, 0x06,
-0x00, 0xFE, 0x80, 0x70, 0x80, 0xFE, 0x00, 0x02, 0x86, 0x48, 0x30, 0x48, 0x86, 0x02, 0x02, 0x0C,
-0x10, 0xE0, 0x10, 0x0C, 0x02, 0x00, 0x82, 0x42, 0x22, 0x12, 0x0A, 0x06, 0x00, 0xC0, 0x28, 0x28,
-0x28, 0xF0, 0x00, 0x00, 0xFF, 0x08, 0x08, 0x08, 0xF0, 0x00, 0x00, 0xF0, 0x08, 0x08, 0x08, 0x90,
-0x00, 0x00, 0xF0, 0x08, 0x08, 0x88, 0xFF, 0x00, 0x00, 0xF0, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00,
-0x08, 0x08, 0xFE, 0x09, 0x09, 0x01, 0x00, 0x70, 0x88, 0x88, 0x88, 0x88, 0xF0, 0x00, 0xFF, 0x10,
-0x08, 0x08, 0xF0, 0x00, 0x00, 0x08, 0x08, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0xFB,
-0x00, 0x00, 0x00, 0xFF, 0x20, 0x50, 0x98, 0x08, 0x00, 0x00, 0x01, 0x01, 0xFF, 0x00, 0x00, 0x00,
-0xF8, 0x10, 0x08, 0xF8, 0x10, 0x08, 0xF8, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF0, 0x00, 0x00, 0xF0,
-0x08, 0x08, 0x08, 0x08, 0xF0, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF0, 0x00, 0x00, 0xF0, 0x08, 0x08,
-0x08, 0xF8, 0x00, 0x00, 0xF8, 0x10, 0x08, 0x08, 0x18, 0x00, 0x00, 0x90, 0x28, 0x28, 0x48, 0x90,
-0x00, 0x08, 0x08, 0xFE, 0x08, 0x08, 0x08, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x80, 0xF8, 0x00, 0x00,
-0x38, 0xC0, 0x00, 0xC0, 0x38, 0x00, 0x00, 0xF8, 0x80, 0x70, 0x80, 0xF8, 0x00, 0x08, 0x18, 0xA0,
-0x40, 0xA0, 0x18, 0x08, 0x00, 0x78, 0x80, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x08, 0x88, 0x68, 0x18,
-0x08, 0x00, 0x60, 0x10, 0x30, 0x60, 0x40, 0x30, 0x00, 0x00, 0x00, 0x00, 0xBF, 0x80, 0x00, 0x00,
-0xF0, 0x0E, 0xF3, 0x09, 0xF9, 0x03, 0xFC, 0x48, 0xE8, 0x5E, 0x48, 0xE8, 0x5E, 0x48, 0x00, 0x0C,
-0x92, 0x7F, 0x22, 0xC0, 0x00, 0x06, 0x89, 0x66, 0x10, 0xCC, 0x22, 0xC1, 0x00, 0x18, 0x04, 0x02,
-0x04, 0x18, 0x00, 0xC0, 0x2E, 0x11, 0x79, 0x8E, 0xE0, 0x00, 0x00, 0x00, 0xF8, 0x06, 0x01, 0x00,
-0x00, 0x00, 0x00, 0x01, 0x06, 0xF8, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x01, 0x01, 0x00, 0x00, 0x00,
-0x00, 0x01, 0x01, 0xFF, 0x00, 0x00, 0x00, 0x20, 0x20, 0xDE, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01,
-0xDE, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x0E, 0x30, 0xC0,
-0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x98, 0x98, 0x00, 0x00,
-0x00, 0x00, 0x00, 0x98, 0x98, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00,
-0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07,
-0x07, 0x00, 0x00, 0x00, 0x07, 0x07, 0x00, 0x07, 0x07, 0x00, 0x00, 0x20, 0x70, 0xD8, 0x88, 0x04,
-0x00, 0x00, 0x04, 0x88, 0xD8, 0x70, 0x20, 0x00, 0x20, 0x20, 0x20, 0xFC, 0x20, 0x20, 0x20, 0x00,
-0x00, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x0A, 0x04, 0x1F, 0x04, 0x0A, 0x00, 0x00, 0x00, 0xC0,
-0x30, 0x0E, 0x01, 0x00, 0x00, 0x50, 0x50, 0x50, 0x50, 0x50, 0x00, 0x00, 0x02, 0xA1, 0xB1, 0x11,
-0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00,
-0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00,
-0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01,
-0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
-0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00,
-0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
-0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01,
-0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00,
-0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01,
-0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01,
-0x01, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01,
-0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-0x01, 0x01, 0x01, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01,
-0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01,
-0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00,
-0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01,
-0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01,
-0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x01,
-0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
-0x00, 0x08, 0x08, 0x08, 0x08, 0x07, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x01,
-0x01, 0x01, 0x01, 0x00, 0x00, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
-0x01, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01,
-0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x0F,
-0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x0F, 0x00, 0x00, 0x01, 0x00, 0x00,
-0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01,
-0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
-0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x08, 0x08,
-0x05, 0x03, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x03, 0x04, 0x09, 0x09, 0x09, 0x01, 0x00,
-0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x07, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00,
-0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01,
-0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x06, 0x08, 0x00, 0x00, 0x00, 0x00, 0x08, 0x06, 0x01, 0x00,
-0x00, 0x00, 0x00, 0x0F, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x00, 0x00, 0x00,
-0x00, 0x00, 0x07, 0x08, 0x08, 0x00, 0x00, 0x08, 0x08, 0x07, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08,
-0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00,
-0x00, 0x00, 0x00, 0x00, 0x04, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00,
-0x00, 0x00, 0x04, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
-0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-0x00, 0x00, 
+const unsigned char Font7x16 [95][14] = {
+{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+{ 0x00, 0x00, 0x00, 0xBF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00 }, // '!'
+{ 0x00, 0x07, 0x07, 0x00, 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '"'
+{ 0x48, 0xE8, 0x5E, 0x48, 0xE8, 0x5E, 0x48, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00 }, // '#'
+{ 0x00, 0x0C, 0x92, 0x7F, 0x22, 0xC0, 0x00, 0x00, 0x01, 0x07, 0x01, 0x01, 0x00, 0x00 }, // '$'
+{ 0x06, 0x89, 0x66, 0x10, 0xCC, 0x22, 0xC1, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00 }, // '%'
+{ 0xC0, 0x2E, 0x11, 0x79, 0x8E, 0xE0, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x01, 0x01 }, // '&'
+{ 0x00, 0x00, 0x00, 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '''
+{ 0x00, 0x00, 0xF8, 0x06, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x06, 0x08, 0x00, 0x00 }, // '('
+{ 0x00, 0x00, 0x01, 0x06, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x08, 0x06, 0x01, 0x00, 0x00 }, // ')'
+{ 0x00, 0x0A, 0x04, 0x1F, 0x04, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '*'
+{ 0x20, 0x20, 0x20, 0xFC, 0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 }, // '+'
+{ 0x00, 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x04, 0x07, 0x03, 0x00, 0x00 }, // ','
+{ 0x00, 0x00, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '-'
+{ 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00 }, // '.'
+{ 0x00, 0x00, 0xC0, 0x30, 0x0E, 0x01, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00 }, // '/'
+{ 0x00, 0xF8, 0x46, 0x22, 0x12, 0x8A, 0x7C, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00 }, // '0'
+{ 0x00, 0x04, 0x02, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00 }, // '1'
+{ 0x00, 0x04, 0x82, 0x42, 0x22, 0x1C, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00 }, // '2'
+{ 0x00, 0x84, 0x12, 0x12, 0x12, 0xEC, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00 }, // '3'
+{ 0x40, 0x60, 0x50, 0x48, 0x44, 0xFE, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00 }, // '4'
+{ 0x00, 0x9E, 0x12, 0x12, 0x12, 0xE2, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00 }, // '5'
+{ 0x00, 0xF8, 0x24, 0x12, 0x12, 0x12, 0xE0, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00 }, // '6'
+{ 0x00, 0x02, 0x02, 0x82, 0x62, 0x1A, 0x06, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 }, // '7'
+{ 0x00, 0xEC, 0x12, 0x12, 0x12, 0xEC, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00 }, // '8'
+{ 0x00, 0x9C, 0x22, 0x22, 0x22, 0x92, 0x7C, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00 }, // '9'
+{ 0x00, 0x00, 0x00, 0x98, 0x98, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00 }, // ':'
+{ 0x00, 0x00, 0x00, 0x98, 0x98, 0x00, 0x00, 0x00, 0x00, 0x04, 0x07, 0x03, 0x00, 0x00 }, // ';'
+{ 0x00, 0x20, 0x70, 0xD8, 0x88, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00 }, // '<'
+{ 0x00, 0x50, 0x50, 0x50, 0x50, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '='
+{ 0x00, 0x04, 0x88, 0xD8, 0x70, 0x20, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '>'
+{ 0x00, 0x02, 0xA1, 0xB1, 0x11, 0x0E, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00 }, // '?'
+{ 0xF0, 0x0E, 0xF3, 0x09, 0xF9, 0x03, 0xFC, 0x03, 0x04, 0x09, 0x09, 0x09, 0x01, 0x00 }, // '@'
+{ 0x00, 0xE0, 0x5C, 0x42, 0x4E, 0x70, 0xC0, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01 }, // 'A'
+{ 0x00, 0xFE, 0x22, 0x22, 0x32, 0xEC, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00 }, // 'B'
+{ 0x00, 0x78, 0x84, 0x02, 0x02, 0x84, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00 }, // 'C'
+{ 0x00, 0xFE, 0x02, 0x02, 0x02, 0x84, 0x78, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00 }, // 'D'
+{ 0x00, 0xFE, 0x12, 0x12, 0x12, 0x12, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00 }, // 'E'
+{ 0x00, 0xFE, 0x12, 0x12, 0x12, 0x12, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 'F'
+{ 0x78, 0x84, 0x02, 0x22, 0x22, 0xE4, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00 }, // 'G'
+{ 0x00, 0xFE, 0x10, 0x10, 0x10, 0xFE, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00 }, // 'H'
+{ 0x00, 0x02, 0x02, 0xFE, 0x02, 0x02, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00 }, // 'I'
+{ 0x00, 0x02, 0x02, 0x02, 0xFE, 0x02, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00 }, // 'J'
+{ 0x00, 0xFE, 0x10, 0x18, 0x24, 0xC2, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00 }, // 'K'
+{ 0x00, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00 }, // 'L'
+{ 0xFE, 0x04, 0x18, 0x20, 0x18, 0x04, 0xFE, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 }, // 'M'
+{ 0x00, 0xFE, 0x04, 0x38, 0xC0, 0xFE, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00 }, // 'N'
+{ 0x78, 0x84, 0x02, 0x02, 0x02, 0x84, 0x78, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00 }, // 'O'
+{ 0x00, 0xFE, 0x22, 0x22, 0x22, 0x1C, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 'P'
+{ 0xF8, 0x04, 0x02, 0x42, 0x82, 0x7C, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x01, 0x00 }, // 'Q'
+{ 0x00, 0xFE, 0x22, 0x22, 0x62, 0x9C, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01 }, // 'R'
+{ 0x00, 0x8C, 0x12, 0x12, 0x22, 0xC4, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00 }, // 'S'
+{ 0x00, 0x02, 0x02, 0xFE, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 }, // 'T'
+{ 0x00, 0xFE, 0x00, 0x00, 0x00, 0x00, 0xFE, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00 }, // 'U'
+{ 0x00, 0x3E, 0xE0, 0x00, 0xE0, 0x38, 0x06, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 }, // 'V'
+{ 0x00, 0xFE, 0x80, 0x70, 0x80, 0xFE, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00 }, // 'W'
+{ 0x02, 0x86, 0x48, 0x30, 0x48, 0x86, 0x02, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01 }, // 'X'
+{ 0x02, 0x0C, 0x10, 0xE0, 0x10, 0x0C, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 }, // 'Y'
+{ 0x00, 0x82, 0x42, 0x22, 0x12, 0x0A, 0x06, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01 }, // 'Z'
+{ 0x00, 0x00, 0xFF, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x08, 0x08, 0x00, 0x00 }, // '['
+{ 0x00, 0x01, 0x0E, 0x30, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00 }, // '\\'
+{ 0x00, 0x00, 0x01, 0x01, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x00, 0x00 }, // ']'
+{ 0x00, 0x18, 0x04, 0x02, 0x04, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '^'
+{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08 }, // '_'
+{ 0x00, 0x01, 0x03, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '`'
+{ 0x00, 0xC0, 0x28, 0x28, 0x28, 0xF0, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00 }, // 'a'
+{ 0x00, 0xFF, 0x08, 0x08, 0x08, 0xF0, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00 }, // 'b'
+{ 0x00, 0xF0, 0x08, 0x08, 0x08, 0x90, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00 }, // 'c'
+{ 0x00, 0xF0, 0x08, 0x08, 0x88, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x01, 0x00 }, // 'd'
+{ 0x00, 0xF0, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01 }, // 'e'
+{ 0x00, 0x08, 0x08, 0xFE, 0x09, 0x09, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 }, // 'f'
+{ 0x00, 0x70, 0x88, 0x88, 0x88, 0x88, 0xF0, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x07 }, // 'g'
+{ 0x00, 0xFF, 0x10, 0x08, 0x08, 0xF0, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00 }, // 'h'
+{ 0x00, 0x08, 0x08, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00 }, // 'i'
+{ 0x00, 0x08, 0x08, 0x08, 0xFB, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00 }, // 'j'
+{ 0x00, 0xFF, 0x20, 0x50, 0x98, 0x08, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00 }, // 'k'
+{ 0x00, 0x01, 0x01, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00 }, // 'l'
+{ 0xF8, 0x10, 0x08, 0xF8, 0x10, 0x08, 0xF8, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01 }, // 'm'
+{ 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF0, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00 }, // 'n'
+{ 0x00, 0xF0, 0x08, 0x08, 0x08, 0x08, 0xF0, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00 }, // 'o'
+{ 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF0, 0x00, 0x00, 0x0F, 0x01, 0x01, 0x01, 0x00, 0x00 }, // 'p'
+{ 0x00, 0xF0, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x0F, 0x00 }, // 'q'
+{ 0x00, 0xF8, 0x10, 0x08, 0x08, 0x18, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 'r'
+{ 0x00, 0x90, 0x28, 0x28, 0x48, 0x90, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00 }, // 's'
+{ 0x08, 0x08, 0xFE, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00 }, // 't'
+{ 0x00, 0xF8, 0x00, 0x00, 0x80, 0xF8, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x01, 0x00 }, // 'u'
+{ 0x00, 0x38, 0xC0, 0x00, 0xC0, 0x38, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 }, // 'v'
+{ 0x00, 0xF8, 0x80, 0x70, 0x80, 0xF8, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00 }, // 'w'
+{ 0x08, 0x18, 0xA0, 0x40, 0xA0, 0x18, 0x08, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01 }, // 'x'
+{ 0x00, 0x78, 0x80, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x08, 0x08, 0x05, 0x03, 0x00, 0x00 }, // 'y'
+{ 0x00, 0x08, 0x88, 0x68, 0x18, 0x08, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00 }, // 'z'
+{ 0x00, 0x20, 0x20, 0xDE, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x07, 0x08, 0x08, 0x00 }, // '{'
+{ 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00 }, // '|'
+{ 0x00, 0x01, 0x01, 0xDE, 0x20, 0x20, 0x00, 0x00, 0x08, 0x08, 0x07, 0x00, 0x00, 0x00 }, // '}'
+{ 0x60, 0x10, 0x30, 0x60, 0x40, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '~'
 };
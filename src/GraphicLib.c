@@ -21,6 +21,7 @@
 /* ************************************************************************** */
 /* ************************************************************************** */
 #include <math.h>
+#include <stdio.h>
 #include <string.h>
 #include "GraphicLib.h"
 #include "Font7x16.h"
@@ -31,20 +32,94 @@
 /* ************************************************************************** */
 /* ************************************************************************** */
 #define  GPL_LAYERS LAYER_MAX
+#define  GPL_PAGES  (LCM_HEIGHT/8)       // 8 rows of pixel per Page byte
+#define  GPL_WORDS  (LCM_WIDTH/4)        // 32-bit Words per Page
+
+// Region in Column(x) and Page(y/8) unit, empty when x0>x1
+typedef struct {
+    int16_t x0, x1;
+    int16_t p0, p1;
+} GPL_RECT;
+
 struct {
-    uint8_t Buf[LCM_FRAME_SIZE]; // (128x64)/8, 1bit/pixel, Layer Buffer
+    uint8_t Buf[LCM_FRAME_SIZE] __attribute__((aligned(4))); // (128x64)/8, 1bit/pixel, Layer Buffer
     uint8_t Show;
+    GPL_RECT Used;  // Region drawn since last Layer Clean
+    GPL_RECT Dirty; // Region changed since last Screen Update
 } GPL_Layer[GPL_LAYERS];
 
 uint8_t  GPL_Invalidate = false;
+uint8_t  GPL_CurLayer = 0;                // Layer of Drawing
+GPL_RECT GPL_PrevDirty;                   // Composed Region of last Frame (Front Frame Buffer)
+GPL_RECT GPL_Scroll;                      // Pages scrolled since last Screen Update
+GPL_RECT GPL_Send;                        // Composed in Back Frame Buffer, waiting for the swap
 uint16_t GPL_PenSize  = 1; // Good for Odd number 1,3,5,7,9
-char     GPL_Alphabet[95] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz~!@#$%^&()[]{}_\\|;:,.`'\"<>+-*/=? ";
 
 /* ************************************************************************** */
 /* ************************************************************************** */
 // Section: Local Functions                                                   */
 /* ************************************************************************** */
 /* ************************************************************************** */
+static void _GPL_RectEmpty( GPL_RECT *pRect )
+{
+    pRect->x0 = LCM_WIDTH;
+    pRect->x1 = -1;
+    pRect->p0 = GPL_PAGES;
+    pRect->p1 = -1;
+}
+
+static void _GPL_RectFull( GPL_RECT *pRect )
+{
+    pRect->x0 = 0;
+    pRect->x1 = LCM_WIDTH-1;
+    pRect->p0 = 0;
+    pRect->p1 = GPL_PAGES-1;
+}
+
+static void _GPL_RectUnion( GPL_RECT *pRect, const GPL_RECT *pAdd )
+{
+    if( pAdd->x0 > pAdd->x1 ) return;
+
+    if( pRect->x0 > pAdd->x0 ) pRect->x0 = pAdd->x0;
+    if( pRect->x1 < pAdd->x1 ) pRect->x1 = pAdd->x1;
+    if( pRect->p0 > pAdd->p0 ) pRect->p0 = pAdd->p0;
+    if( pRect->p1 < pAdd->p1 ) pRect->p1 = pAdd->p1;
+}
+
+static bool _GPL_RectOverlap( const GPL_RECT *pA, const GPL_RECT *pB )
+{
+    return ( pA->x0 <= pB->x1 && pB->x0 <= pA->x1 &&
+             pA->p0 <= pB->p1 && pB->p0 <= pA->p1 );
+}
+
+// Changed Region moved along with scrolled Band, kept on the Columns it leaves
+static void _GPL_RectScroll( GPL_RECT *pRect, const GPL_RECT *pBand, uint8_t columns )
+{
+    if( !_GPL_RectOverlap( pRect, pBand ) ) return;
+    pRect->x0 = ( pRect->x0 > columns ) ? pRect->x0-columns : 0;
+}
+
+// Mark pixel region (x,y,w,h) of drawing Layer as changed
+static void _GPL_Invalidate( int16_t x, int16_t y, int16_t w, int16_t h )
+{
+    GPL_RECT Rect;
+
+    if( x < 0 ) { w += x; x = 0; }
+    if( y < 0 ) { h += y; y = 0; }
+    if( x+w > LCM_WIDTH  ) w = LCM_WIDTH-x;
+    if( y+h > LCM_HEIGHT ) h = LCM_HEIGHT-y;
+    if( w <= 0 || h <= 0 ) return;
+
+    Rect.x0 = x;
+    Rect.x1 = x+w-1;
+    Rect.p0 = y/8;
+    Rect.p1 = (y+h-1)/8;
+    _GPL_RectUnion( &GPL_Layer[GPL_CurLayer].Used,  &Rect );
+    _GPL_RectUnion( &GPL_Layer[GPL_CurLayer].Dirty, &Rect );
+
+    // Request to Update Screen
+    GPL_Invalidate = true;
+}
 
 /* ************************************************************************** */
 /* ************************************************************************** */
@@ -66,7 +141,17 @@ uint8_t GPL_ScreenInit( void )
     for( int Layer=0 ; Layer < GPL_LAYERS ; Layer++ )
     {
         GPL_Layer[Layer].Show = GPL_SHOW;
+        _GPL_RectEmpty( &GPL_Layer[Layer].Used );
+        _GPL_RectEmpty( &GPL_Layer[Layer].Dirty );
     }
+
+    // Both Frame Buffers and GDDRAM are unknown, compose and send full Frame at first
+    _GPL_RectFull( &GPL_PrevDirty );
+    _GPL_RectFull( &GPL_Layer[0].Dirty );
+    _GPL_RectEmpty( &GPL_Scroll );
+    _GPL_RectEmpty( &GPL_Send );
+    GPL_Invalidate = true;
+
     return LCM_Init();
 }
 
@@ -75,58 +160,160 @@ void GPL_LayerSet( uint8_t index )
     if( index < GPL_LAYERS )
     {
         // Assign Layer Frame Buffer
+        GPL_CurLayer = index;
         LCM_SetLayerBuf( GPL_Layer[index].Buf );
     }
 }
 
 void GPL_LayerShow( uint8_t index, uint8_t show )
 {
-    if( index < GPL_LAYERS )
+    if( index < GPL_LAYERS && GPL_Layer[index].Show != show )
     {
-        // Assign Layer Frame Buffer
+        // Layer content appears/disappears on Screen
         GPL_Layer[index].Show = show;
+        _GPL_RectUnion( &GPL_Layer[index].Dirty, &GPL_Layer[index].Used );
+        GPL_Invalidate = true;
     }
 }
 
 void GPL_LayerClean( uint8_t index )
 {
+    GPL_RECT *pUsed;
+    uint32_t *pWord;
+
     if( index < GPL_LAYERS )
     {
-        // Assign Layer Frame Buffer
-        memset(GPL_Layer[index].Buf, 0, sizeof(GPL_Layer[index].Buf));
+        pUsed = &GPL_Layer[index].Used;
+
+        // Erase only the Pages ever drawn since last Clean
+        if( pUsed->x0 <= pUsed->x1 )
+        {
+            pWord = ( uint32_t* )GPL_Layer[index].Buf;
+            memset( pWord+(pUsed->p0*GPL_WORDS), 0, (pUsed->p1-pUsed->p0+1)*LCM_WIDTH );
+
+            _GPL_RectUnion( &GPL_Layer[index].Dirty, pUsed );
+            _GPL_RectEmpty( pUsed );
+            GPL_Invalidate = true;
+        }
     }
 }
 
 void GPL_ScreenClean( void )
 {
-    LCM_Clean();
+    GPL_LayerClean( GPL_CurLayer );
+}
 
-    // Request to Update Screen
+void GPL_ScrollLeft( uint8_t page0, uint8_t page1, uint8_t columns )
+{
+    GPL_RECT Band = { 0, LCM_WIDTH-1, page0, page1 };
+    GPL_RECT Edge = { LCM_WIDTH-1, LCM_WIDTH-1, page0, page1 };
+    uint8_t *pPage;
+
+    if( page0 > page1 || page1 >= GPL_PAGES || columns==0 ) return;
+    if( columns > LCM_WIDTH ) columns = LCM_WIDTH;
+
+    // Controller scrolls the composed Screen, so every Layer and its changes not sent yet move along
+    _GPL_RectScroll( &GPL_Send, &Band, columns );
+    for( int Layer=0 ; Layer < GPL_LAYERS ; Layer++ )
+    {
+        _GPL_RectScroll( &GPL_Layer[Layer].Dirty, &Band, columns );
+        _GPL_RectScroll( &GPL_Layer[Layer].Used,  &Band, columns );
+        for( int Page=page0 ; Page<=page1 ; Page++ )
+        {
+            pPage = &GPL_Layer[Layer].Buf[Page*LCM_WIDTH];
+            memmove( pPage, pPage+columns, LCM_WIDTH-columns );
+            memset( pPage+LCM_WIDTH-columns, 0, columns );
+        }
+    }
+
+    // Frame Buffers follow at next Update, GDDRAM by one Column Scroll Command or by sending the Pages again,
+    // vacated right Column is sent anyway, controller wraps Column 0 into it
+    _GPL_RectUnion( &GPL_Scroll, &Band );
+    if( columns==1 && LCM_ScrollLeft( page0, page1 ) )
+        _GPL_RectUnion( &GPL_Layer[GPL_CurLayer].Dirty, &Edge );
+    else
+        _GPL_RectUnion( &GPL_Layer[GPL_CurLayer].Dirty, &Band );
     GPL_Invalidate = true;
 }
 
 void GPL_ScreenUpdate( void )
 {
-    uint8_t *pFrame = NULL;
-    uint16_t  Layer, Byte;
+    uint32_t *pFrame = NULL;
+    const uint32_t *pLayer[GPL_LAYERS];
+    GPL_RECT Region, Dirty;
+    uint16_t Layer, Count, Page, Word, WordEnd;
 
-    // If Update Screen is requested
+    // If Update Screen is requested, Back Frame Buffer is composed while Front is still in transfer
     if( GPL_Invalidate )
     {
-        pFrame = LCM_GetFrameBuf();
-        memset( pFrame, 0, LCM_FRAME_SIZE );
+        GPL_Invalidate = false;
+
+        // Changed Region of this Frame
+        _GPL_RectEmpty( &Dirty );
         for( Layer=0 ; Layer < GPL_LAYERS ; Layer++ )
         {
-            if( GPL_Layer[Layer].Show == GPL_SHOW )
+            _GPL_RectUnion( &Dirty, &GPL_Layer[Layer].Dirty );
+            _GPL_RectEmpty( &GPL_Layer[Layer].Dirty );
+        }
+
+        // Back Frame Buffer still holds the Frame before last, also catch up last Frame changes,
+        // scrolled Pages are composed again as a whole
+        Region = Dirty;
+        _GPL_RectUnion( &Region, &GPL_Scroll );
+        _GPL_RectUnion( &Region, &GPL_PrevDirty );
+
+        if( Region.x0 <= Region.x1 )
+        {
+            // Composed in whole Words, a Layer with content only in the rest of a Word takes part too
+            Region.x0 &= ~3;
+            Region.x1 |= 3;
+
+            // Only the shown Layers with content in Region take part
+            for( Layer=0, Count=0 ; Layer < GPL_LAYERS ; Layer++ )
+            {
+                if( GPL_Layer[Layer].Show == GPL_SHOW &&
+                    _GPL_RectOverlap( &GPL_Layer[Layer].Used, &Region ) )
+                {
+                    pLayer[Count++] = ( const uint32_t* )GPL_Layer[Layer].Buf;
+                }
+            }
+
+            // Compose Region in 32-bit Words, 4 Columns of a Page per Word
+            pFrame  = ( uint32_t* )LCM_GetFrameBuf();
+            WordEnd = (Region.x1>>2);
+            for( Page=Region.p0 ; Page<=Region.p1 ; Page++ )
             {
-                for( Byte=0 ; Byte<LCM_FRAME_SIZE ; Byte++ )
+                for( Word=(Page*GPL_WORDS)+(Region.x0>>2) ; Word<=(Page*GPL_WORDS)+WordEnd ; Word++ )
                 {
-                    pFrame[Byte]|=GPL_Layer[Layer].Buf[Byte];
+                    uint32_t Pixels = 0;
+
+                    for( Layer=0 ; Layer < Count ; Layer++ )
+                    {
+                        Pixels |= pLayer[Layer][Word];
+                    }
+                    pFrame[Word] = Pixels;
                 }
             }
+
+            // Back Frame Buffer caught up, changes wait in it for the swap
+            _GPL_RectEmpty( &GPL_PrevDirty );
+            _GPL_RectUnion( &GPL_Send, &Dirty );
+
+            // Back to drawing Layer
+            LCM_SetLayerBuf( GPL_Layer[GPL_CurLayer].Buf );
         }
-        LCM_Update();
-        GPL_Invalidate = false;
+    }
+
+    // Only the swap waits for previous Frame transfer, a composed Frame not taken goes at next Update,
+    // called with nothing to send too, a failed Frame is sent again
+    if( LCM_UpdateWindow( GPL_Send.x0, GPL_Send.x1, GPL_Send.p0, GPL_Send.p1 ) )
+    {
+        // Only the changed Window goes out, GDDRAM keeps the rest,
+        // new Back Frame Buffer lacks it and the scrolled Pages
+        _GPL_RectUnion( &GPL_Send, &GPL_Scroll );
+        GPL_PrevDirty = GPL_Send;
+        _GPL_RectEmpty( &GPL_Send );
+        _GPL_RectEmpty( &GPL_Scroll );
     }
 }
 
@@ -137,7 +324,7 @@ void GPL_DrawPoint( uint16_t x, uint16_t y, uint8_t pixel )
     LCM_Region( x-(GPL_PenSize>>1), y-(GPL_PenSize>>1), GPL_PenSize, GPL_PenSize, pixel );
 
     // Request to Update Screen
-    GPL_Invalidate = true;
+    _GPL_Invalidate( x-(GPL_PenSize>>1), y-(GPL_PenSize>>1), GPL_PenSize, GPL_PenSize );
 }
 
 void GPL_DrawLine( uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2 )
@@ -196,7 +383,15 @@ void GPL_FillRect( uint16_t x, uint16_t y, uint16_t w, uint16_t h )
     LCM_Region( x, y, w, h, PIXEL_SET );
 
     // Request to Update Screen
-    GPL_Invalidate = true;
+    _GPL_Invalidate( x, y, w, h );
+}
+
+void GPL_ClearRect( uint16_t x, uint16_t y, uint16_t w, uint16_t h )
+{
+    LCM_Region( x, y, w, h, PIXEL_CLEAN );
+
+    // Request to Update Screen
+    _GPL_Invalidate( x, y, w, h );
 }
 
 void GPL_DrawCross( uint16_t x0, uint16_t y0, uint16_t r )
@@ -277,61 +472,161 @@ void GPL_DrawBitmap( uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t bac
     LCM_Bitmap( x, y, w, h, background, bitmap );
 
     // Request to Update Screen
-    GPL_Invalidate = true;
+    _GPL_Invalidate( x, y, w, h );
 }
 
 void GPL_DrawFont( uint16_t x, uint16_t y, char chr, uint8_t background, uint8_t highlight )
 {
-    uint16_t chIdx = 0;
-    uint8_t FontChar[FONT_WIDTH*FONT_HEIGHT/8];
-
-    // Search chr in GPL_Alphabet[]
-    while( chr != GPL_Alphabet[chIdx] && chIdx<sizeof(GPL_Alphabet) )
-    { chIdx++; }
-    if( chIdx>=sizeof(GPL_Alphabet) )
+    // Font7x16[] is in ASCII order, 2 Pages x FONT_WIDTH Columns per Glyph
+    if( chr < FONT_FIRST_CHAR || chr > FONT_LAST_CHAR )
     { return; }
 
-    // Extract chr bitmap from Font Bitmap, Font Bitmap height should multiple of 8 (8, 16, 24 ...)
-    // Example of Two Font Char and Font Width = 7, Height = 16
-    //
-    // Font Bitmap Array = Byte00, Byte01, Byte02, ... Byte15,| Byte16, Byte17, ... Byte 31
-    //
-    //                           [ Font Char 1 ]   [ Font Char 2 ]
-    //                         |    Font W=7     |     Font W=7
-    // Font H = 16 | Bit[0: 7] | Byte00 - Byte07 |  Byte08 - Byte15
-    //             | Bit[8:15] | Byte16 - Byte23 |  Byte24 - Byte31
-
-    // First Row of Font
-    memcpy(FontChar,            Font7x16+(chIdx*FONT_WIDTH),                        FONT_WIDTH);
-    // Second Row of Font
-    memcpy(FontChar+FONT_WIDTH, Font7x16+((chIdx+sizeof(GPL_Alphabet))*FONT_WIDTH), FONT_WIDTH);
-
-    // Highlight(Invert) font
-    if( highlight )
+    LCM_BitmapBlit( x, y, FONT_WIDTH, FONT_HEIGHT, background, highlight, Font7x16[chr-FONT_FIRST_CHAR] );
+
+    // Request to Update Screen
+    _GPL_Invalidate( x, y, FONT_WIDTH, FONT_HEIGHT );
+}
+
+void GPL_DrawRowString( uint16_t x, uint16_t row, char *str, uint8_t background, uint8_t highlight )
+{
+    GPL_DrawString( x, row*FONT_HEIGHT, str, background, highlight );
+}
+
+// Blit Glyph rows [0,h) of str, return x after last Glyph
+static uint16_t _GPL_BlitString( uint16_t x, uint16_t y, uint16_t h, const char *str, uint8_t background, uint8_t highlight )
+{
+    uint16_t xStart = x;
+
+    // Blit Glyphs until end of string or Screen
+    for( ; *str != '\0' && x < LCM_WIDTH ; str++, x += FONT_WIDTH )
     {
-        for(int i=0 ; i<FONT_WIDTH*(FONT_HEIGHT+(FONT_HEIGHT%8))/8 ; i++ )
+        if( *str >= FONT_FIRST_CHAR && *str <= FONT_LAST_CHAR )
         {
-            FontChar[i] = ~FontChar[i];
+            LCM_BitmapBlit( x, y, FONT_WIDTH, h, background, highlight, Font7x16[*str-FONT_FIRST_CHAR] );
         }
     }
 
-    GPL_DrawBitmap(x, y, FONT_WIDTH, FONT_HEIGHT, background, FontChar);
+    // Request to Update Screen
+    _GPL_Invalidate( xStart, y, x-xStart, h );
+
+    return x;
 }
 
-void GPL_DrawRowString( uint16_t x, uint16_t row, char *str, uint8_t background, uint8_t highlight )
+void GPL_DrawString( uint16_t x, uint16_t y, char *str, uint8_t background, uint8_t highlight )
+{
+    _GPL_BlitString( x, y, FONT_HEIGHT, str, background, highlight );
+}
+
+// ****************************************************************************
+//  Widget
+// ****************************************************************************
+// Left edge of a w pixels wide content at Widget anchor
+static uint16_t _GPL_WidgetLeft( GPL_WIDGET *pWidget, uint16_t w )
 {
-    for( int chrIdx=0 ; chrIdx<strlen(str); chrIdx++ )
+    switch( pWidget->Align )
     {
-        GPL_DrawFont( x+(chrIdx*FONT_WIDTH), row*FONT_HEIGHT, str[chrIdx], background, highlight );
+        case GPL_ALIGN_CENTER: return ( pWidget->x > (w+1)/2 ) ? pWidget->x-(w+1)/2 : 0;
+        case GPL_ALIGN_RIGHT:  return ( pWidget->x > w ) ? pWidget->x-w : 0;
+        default:               return pWidget->x;
     }
 }
 
-void GPL_DrawString( uint16_t x, uint16_t y, char *str, uint8_t background, uint8_t highlight )
+// Erase old box and move drawing to Widget Layer, return Layer to restore
+static uint8_t _GPL_WidgetBegin( GPL_WIDGET *pWidget )
 {
-    for( int chrIdx=0 ; chrIdx<strlen(str); chrIdx++ )
+    uint8_t Layer = GPL_CurLayer;
+
+    GPL_LayerSet( pWidget->Layer );
+    if( pWidget->BoxW )
     {
-        GPL_DrawFont( x+(chrIdx*FONT_WIDTH), y, str[chrIdx], background, highlight );
+        // Box part on Screen
+        if( pWidget->BoxX+pWidget->BoxW > LCM_WIDTH  ) pWidget->BoxW = LCM_WIDTH-pWidget->BoxX;
+        if( pWidget->y+pWidget->BoxH    > LCM_HEIGHT ) pWidget->BoxH = LCM_HEIGHT-pWidget->y;
+        GPL_ClearRect( pWidget->BoxX, pWidget->y, pWidget->BoxW, pWidget->BoxH );
+        pWidget->BoxW = 0;
     }
+    return Layer;
+}
+
+static void _GPL_WidgetPaintText( GPL_WIDGET *pWidget )
+{
+    uint8_t Layer = _GPL_WidgetBegin( pWidget );
+
+    // Text Box covers the real Glyph rows only, rows below belong to others
+    pWidget->BoxX = _GPL_WidgetLeft( pWidget, strlen( pWidget->Text )*FONT_WIDTH );
+    pWidget->BoxW = _GPL_BlitString( pWidget->BoxX, pWidget->y, FONT_HEIGHT_REAL, pWidget->Text, BG_SOLID, TEXT_NORMAL )-pWidget->BoxX;
+    pWidget->BoxH = FONT_HEIGHT_REAL;
+    pWidget->Shown = true;
+
+    GPL_LayerSet( Layer );
+}
+
+void GPL_WidgetPlace( GPL_WIDGET *pWidget, uint8_t layer, uint16_t x, uint16_t y, uint8_t align )
+{
+    if( pWidget->Layer==layer && pWidget->x==x && pWidget->y==y && pWidget->Align==align )
+    { return; }
+
+    // Moved, erase at old place and paint at new place on next content
+    GPL_WidgetHide( pWidget );
+    pWidget->Layer = layer;
+    pWidget->x     = x;
+    pWidget->y     = y;
+    pWidget->Align = align;
+}
+
+bool GPL_WidgetHide( GPL_WIDGET *pWidget )
+{
+    uint8_t Layer;
+
+    if( !pWidget->Shown ) return false;
+
+    Layer = _GPL_WidgetBegin( pWidget );
+    GPL_LayerSet( Layer );
+    pWidget->Shown = false;
+
+    return true;
+}
+
+void GPL_WidgetText( GPL_WIDGET *pWidget, const char *str )
+{
+    if( pWidget->Shown && pWidget->pContent==NULL &&
+        strncmp( pWidget->Text, str, GPL_WIDGET_TEXT_SIZE-1 )==0 )
+    { return; }
+
+    strncpy( pWidget->Text, str, GPL_WIDGET_TEXT_SIZE-1 );
+    pWidget->Text[GPL_WIDGET_TEXT_SIZE-1] = '\0';
+    pWidget->pContent = NULL;
+    _GPL_WidgetPaintText( pWidget );
+}
+
+void GPL_WidgetNumber( GPL_WIDGET *pWidget, const char *format, int32_t value )
+{
+    if( pWidget->Shown && pWidget->pContent==format && pWidget->Value==value )
+    { return; }
+
+    snprintf( pWidget->Text, GPL_WIDGET_TEXT_SIZE, format, ( int )value );
+    pWidget->pContent = format;
+    pWidget->Value    = value;
+    _GPL_WidgetPaintText( pWidget );
+}
+
+void GPL_WidgetBitmap( GPL_WIDGET *pWidget, uint16_t w, uint16_t h, const unsigned char *bitmap )
+{
+    uint8_t Layer;
+
+    if( pWidget->Shown && pWidget->pContent==bitmap )
+    { return; }
+
+    Layer = _GPL_WidgetBegin( pWidget );
+
+    pWidget->BoxX = _GPL_WidgetLeft( pWidget, w );
+    pWidget->BoxW = w;
+    pWidget->BoxH = h;
+    GPL_DrawBitmap( pWidget->BoxX, pWidget->y, w, h, BG_SOLID, bitmap );
+    pWidget->pContent = bitmap;
+    pWidget->Shown    = true;
+
+    GPL_LayerSet( Layer );
 }
 
 /* *****************************************************************************
@@ -48,6 +48,8 @@ extern "C" {
 #define FONT_WIDTH       7
 #define FONT_HEIGHT      16
 #define FONT_HEIGHT_REAL 12
+#define FONT_FIRST_CHAR  ' '  // Font7x16 covers printable ASCII
+#define FONT_LAST_CHAR   '~'
 
 // Math
 #define PI              3.14159
@@ -80,6 +82,28 @@ enum {
     GPL_SHOW,
 };
 
+enum {
+    GPL_ALIGN_LEFT = 0,  // Widget anchor x is left edge
+    GPL_ALIGN_CENTER,    // Widget anchor x is center
+    GPL_ALIGN_RIGHT      // Widget anchor x is right edge (exclusive)
+};
+
+// Widget text/number length
+#define GPL_WIDGET_TEXT_SIZE 20
+
+// Retained Widget, keeps its content and painted box, repaints only on change
+// A zero initialized Widget is hidden at (0,0) of Layer 0
+typedef struct {
+    uint8_t  Layer;
+    uint8_t  Align;
+    uint16_t x, y;          // Anchor
+    bool     Shown;
+    uint16_t BoxX, BoxW, BoxH; // Region painted, BoxW=0 for none
+    const void *pContent;   // Bitmap or Number format (one int) shown, NULL for Text
+    int32_t  Value;         // Number shown
+    char     Text[GPL_WIDGET_TEXT_SIZE]; // Text shown
+} GPL_WIDGET;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Interface Functions
@@ -91,18 +115,25 @@ void GPL_LayerShow( uint8_t index, uint8_t show );
 void GPL_LayerClean( uint8_t index );
 void GPL_ScreenClean( void );
 void GPL_ScreenUpdate( void );
+void GPL_ScrollLeft( uint8_t page0, uint8_t page1, uint8_t columns );
 void GPL_SetPenSize( uint16_t pixel );
 uint16_t GPL_GetPenSize( uint16_t pixel );
 void GPL_DrawPoint( uint16_t x, uint16_t y, uint8_t pixel );
 void GPL_DrawLine( uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2 );
 void GPL_DrawRect( uint16_t x, uint16_t y, uint16_t w, uint16_t h );
 void GPL_FillRect( uint16_t x, uint16_t y, uint16_t w, uint16_t h );
+void GPL_ClearRect( uint16_t x, uint16_t y, uint16_t w, uint16_t h );
 void GPL_DrawCross( uint16_t x0, uint16_t y0, uint16_t r );
 void GPL_DrawCircle( uint16_t x0, uint16_t y0, uint16_t r );
 void GPL_DrawBitmap( uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t background, const unsigned char *bitmap );
 void GPL_DrawFont( uint16_t x, uint16_t y, char chr, uint8_t background, uint8_t highlight );
 void GPL_DrawRowString( uint16_t x, uint16_t row, char *str, uint8_t background, uint8_t highlight );
 void GPL_DrawString( uint16_t x, uint16_t y, char *str, uint8_t background, uint8_t highlight );
+void GPL_WidgetPlace( GPL_WIDGET *pWidget, uint8_t layer, uint16_t x, uint16_t y, uint8_t align );
+bool GPL_WidgetHide( GPL_WIDGET *pWidget );
+void GPL_WidgetText( GPL_WIDGET *pWidget, const char *str );
+void GPL_WidgetNumber( GPL_WIDGET *pWidget, const char *format, int32_t value );
+void GPL_WidgetBitmap( GPL_WIDGET *pWidget, uint16_t w, uint16_t h, const unsigned char *bitmap );
 
 /* Provide C++ Compatibility */
 #ifdef __cplusplus
@@ -24,27 +24,35 @@
 /* ************************************************************************** */
 /* ************************************************************************** */
 #include "LCM.h"
-#include "peripheral/port/plib_port.h"
-#include "peripheral/sercom/spi_master/plib_sercom4_spi_master.h"
 
 /* ************************************************************************** */
 /* ************************************************************************** */
 /* Section: File Scope or Global Data                                         */
 /* ************************************************************************** */
 /* ************************************************************************** */
-// TIME system service
-// SPI DRIVER
-// SERCOM SPI     : MOSI (PB10)
-// SERCOM SPI     : SCK  (PB11)
-// SERCOM SPI     : SS   (PA13)          , Hardware control
-// SSD1306_CS     : SS   (PA13)          , GPIO Output Latch high
-// SSD1306_RESET  : Reset(PA27)          , GPIO Output Latch high
-// SSD1306_RS     : A0/Data/Command(PA12), GPIO Output Latch high
-#define OLED_RESET_ENABLE  0  // Enable OLED Reset PIN on PA27
-#define OLED_CS_PIN_GPIO   1  // Enable SPI GPIO Slave Select on PA13
-
-uint8_t LCM_FrameBuf[LCM_FRAME_SIZE]; // (128x64)/8, 1bit/pixel
+// Pixel data goes out as SSD1306 Command/Data byte stream through LCM_pBackend
+// LCM_SSD1306.c : SERCOM4 SPI (DMAC) on target
+// LCM_Host.c    : SSD1306 emulation into image on host (tools/oled_host)
+
+uint8_t LCM_FrameBuf[2][LCM_FRAME_SIZE] __attribute__((aligned(4))); // Front/Back Frame Buffer, (128x64)/8, 1bit/pixel
+uint8_t LCM_BackIdx = 0; // The Back Frame Buffer index, Front is being transferred
 uint8_t *LCM_pFrameBuf = NULL; // The Frame Buffer Pointer
+uint32_t LCM_FrameCount = 0; // Frames sent to Backend
+
+// One Column content scroll (2Ch/2Dh) is only in SSD1306B/SSD1309/SSD1315, a plain SSD1306 lacks it.
+// Off, a scrolled Band goes out as a full Window. Set 1 only with one of those controllers.
+#ifndef LCM_SCROLL_ENABLE
+#define LCM_SCROLL_ENABLE    0
+#endif
+#define LCM_SCROLL_CMD       0x2D // Content toward Column 0, 0x2C if the panel moves the other way
+#define LCM_SCROLL_CMD_SIZE  7
+#define LCM_SCROLL_QUEUE     1    // Controller needs 2 display Frames between Scrolls, one per Update
+
+uint8_t LCM_ScrollCMD[LCM_SCROLL_QUEUE*LCM_SCROLL_CMD_SIZE]; // Scroll Commands for next Update
+uint8_t LCM_ScrollSize = 0;
+uint8_t LCM_XferCMD[sizeof(LCM_ScrollCMD)+6];                // Scroll and Window Commands under transfer
+uint8_t LCM_XferBuf[LCM_FRAME_SIZE/2] __attribute__((aligned(4))); // Narrow Window gathered from Frame Buffer
+const LCM_BACKEND *LCM_pBackend = &LCM_BACKEND_DEFAULT; // Display Backend
 const uint8_t LCM_InitCMD[]={
     0xAE,          // DISPLAY OFF
     0xD5,          // SET OSC FREQUENY
@@ -57,7 +65,7 @@ const uint8_t LCM_InitCMD[]={
     0x8D,          // ENABLE CHARGE PUMP REGULATOR
     0x14,          //
     0x20,          // SET MEMORY ADDRESSING MODE
-    0x02,          // horizontal addressing mode
+    0x00,          // horizontal addressing mode
     0xA1,          // set segment re-map, column address 127 is mapped to SEG0
     0xC8,          // set COM/Output scan direction, remapped mode (COM[N-1] to COM0)
     0xDA,          // SET COM PINS HARDWARE CONFIGURATION
@@ -72,14 +80,6 @@ const uint8_t LCM_InitCMD[]={
     0xA6,          // TEXT_NORMAL MODE (A7 for inverse display)
     0xAF           // DISPLAY ON
 };
-
-// *****************************************************************************
-// *****************************************************************************
-// Section: Application Callback Functions
-// *****************************************************************************
-// *****************************************************************************
-
-
 // *****************************************************************************
 // *****************************************************************************
 // Section: Application Local Functions
@@ -137,40 +137,33 @@ void LCM_SetLayerBuf( uint8_t *pLayer )
 
 uint8_t* LCM_GetFrameBuf( void )
 {
-    // Return LCM Frame Buffer Address for Merge
-    LCM_pFrameBuf = LCM_FrameBuf;
+    // Return LCM Back Frame Buffer Address for Merge
+    LCM_pFrameBuf = LCM_FrameBuf[LCM_BackIdx];
 
     return LCM_pFrameBuf;
 }
 
-uint8_t LCM_Init( void )
+bool LCM_IsBusy( void )
 {
-#if OLED_RESET_ENABLE
-    // Reset Start
-    SSD1306_RESET_Clear();
-
-    // Reset Release
-    SSD1306_RESET_Set();
-#endif
+    // Front Frame Buffer is still under transfer
+    return LCM_pBackend->IsBusy();
+}
 
-#if OLED_CS_PIN_GPIO
-    // Chip Enable
-    SSD1306_CS_Clear();
-#endif
+uint32_t LCM_GetFrameCount( void )
+{
+    return LCM_FrameCount;
+}
 
-    // Command Transfer
-    SSD1306_RS_Clear();
+uint8_t LCM_Init( void )
+{
+    if( LCM_pBackend->Init()==false ) return false;
 
     // Send LCM Init Command
-    SERCOM4_SPI_Write(( void* )LCM_InitCMD, sizeof (LCM_InitCMD));
-
-#if OLED_CS_PIN_GPIO
-    // Chip Disable
-    SSD1306_CS_Set();
-#endif
+    LCM_pBackend->Command( LCM_InitCMD, sizeof(LCM_InitCMD) );
 
     // Assign Default FrameBuf
-    LCM_pFrameBuf = LCM_FrameBuf;
+    LCM_BackIdx = 0;
+    LCM_pFrameBuf = LCM_FrameBuf[LCM_BackIdx];
 
     return true;
 }
@@ -178,39 +171,100 @@ uint8_t LCM_Init( void )
 void LCM_Clean( void )
 {
     // Erase Frame Buffer
-    memset(( void* )LCM_pFrameBuf, 0, 1024);
+    memset(( void* )LCM_pFrameBuf, 0, LCM_FRAME_SIZE);
 }
 
-void LCM_Update( void )
+bool LCM_UpdateWindow( uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1 )
 {
-    uint8_t *pFrame = LCM_pFrameBuf;
-    uint8_t PixelAddr[3] = {0x00, 0x10, 0xB0};
+    const uint8_t *pData;
+    size_t CmdSize, DataSize = 0;
+    uint8_t Width, Page;
 
-#if OLED_CS_PIN_GPIO
-    // Chip Enable
-    SSD1306_CS_Clear();
-#endif
+    // Previous Frame still going out, keep drawing to Back Frame Buffer
+    if( LCM_IsBusy() ) return false;
 
-    // Update full Frame
-    while( PixelAddr[2] < (0xB0+(LCM_HEIGHT/8)) )
+    // Previous Frame failed, GDDRAM is unknown, send whole Front Frame Buffer again before the swap
+    if( LCM_pBackend->Failed() )
     {
-        // Command Transfer (Pixel Address)
-        SSD1306_RS_Clear();
-        SERCOM4_SPI_Write(( void* )PixelAddr, 3);
+        const uint8_t FullCMD[] = { 0x21, 0, LCM_WIDTH-1, 0x22, 0, (LCM_HEIGHT/8)-1 };
+
+        memcpy( LCM_XferCMD, FullCMD, sizeof(FullCMD) );
+        LCM_pBackend->Transfer( LCM_XferCMD, sizeof(FullCMD), LCM_FrameBuf[LCM_BackIdx^1], LCM_FRAME_SIZE );
+        return false;
+    }
 
-        // Data Transfer (Pixel Data)
-        SSD1306_RS_Set();
-        SERCOM4_SPI_Write(( void* )pFrame, LCM_WIDTH);
+    // Queued Scrolls go first, the Window is then written on scrolled GDDRAM
+    memcpy( LCM_XferCMD, LCM_ScrollCMD, LCM_ScrollSize );
+    CmdSize = LCM_ScrollSize;
+    pData   = LCM_FrameBuf[LCM_BackIdx];
+
+    // Window of Columns x0-x1 in Pages p0-p1, empty when x0>x1 (Scroll only)
+    if( x0 <= x1 && x1 < LCM_WIDTH && p0 <= p1 && p1 < LCM_HEIGHT/8 )
+    {
+        Width = x1-x0+1;
+        if( Width < LCM_WIDTH && (uint32_t)Width*(uint32_t)(p1-p0+1) <= sizeof(LCM_XferBuf) )
+        {
+            // Narrow Window, gather its Columns of each Page
+            for( Page=p0 ; Page<=p1 ; Page++ )
+            {
+                memcpy( &LCM_XferBuf[DataSize], &pData[(Page*LCM_WIDTH)+x0], Width );
+                DataSize += Width;
+            }
+            pData = LCM_XferBuf;
+        }
+        else
+        {
+            // Wide Window, full Pages are contiguous in Frame Buffer
+            x0 = 0;
+            x1 = LCM_WIDTH-1;
+            pData   += p0*LCM_WIDTH;
+            DataSize = (p1-p0+1)*LCM_WIDTH;
+        }
 
-        // Index to next 8 row for Pixels
-        pFrame += LCM_WIDTH;
-        PixelAddr[2]++;
+        LCM_XferCMD[CmdSize++] = 0x21; // SET COLUMN ADDRESS
+        LCM_XferCMD[CmdSize++] = x0;
+        LCM_XferCMD[CmdSize++] = x1;
+        LCM_XferCMD[CmdSize++] = 0x22; // SET PAGE ADDRESS
+        LCM_XferCMD[CmdSize++] = p0;
+        LCM_XferCMD[CmdSize++] = p1;
     }
 
-#if OLED_CS_PIN_GPIO
-    // Chip Disable
-    SSD1306_CS_Set();
-#endif
+    if( CmdSize==0 ) return false;
+    if( LCM_pBackend->Transfer( LCM_XferCMD, CmdSize, pData, DataSize )==false )
+        return false;
+    LCM_ScrollSize = 0;
+
+    // Swap Back Frame Buffer to Front for transfer
+    LCM_BackIdx ^= 1;
+    LCM_pFrameBuf = LCM_FrameBuf[LCM_BackIdx];
+    LCM_FrameCount++;
+
+    return true;
+}
+
+bool LCM_Update( void )
+{
+    // Full Frame
+    return LCM_UpdateWindow( 0, LCM_WIDTH-1, 0, (LCM_HEIGHT/8)-1 );
+}
+
+bool LCM_ScrollLeft( uint8_t p0, uint8_t p1 )
+{
+    uint8_t *pCmd = &LCM_ScrollCMD[LCM_ScrollSize];
+
+    // GDDRAM of Pages p0-p1 moves one Column toward Column 0 at next Update
+    if( !LCM_SCROLL_ENABLE || LCM_ScrollSize >= sizeof(LCM_ScrollCMD) ) return false;
+
+    pCmd[0] = LCM_SCROLL_CMD;
+    pCmd[1] = 0x00;          // dummy
+    pCmd[2] = p0;            // start page
+    pCmd[3] = 0x01;          // dummy
+    pCmd[4] = p1;            // end page
+    pCmd[5] = 0x00;          // start column
+    pCmd[6] = LCM_WIDTH-1;   // end column
+    LCM_ScrollSize += LCM_SCROLL_CMD_SIZE;
+
+    return true;
 }
 
 void LCM_Pixel( uint16_t x, uint16_t y, uint8_t pixel )
@@ -237,29 +291,55 @@ void LCM_Region( uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t pixel )
     }
 }
 
-void LCM_Bitmap( uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t background, const unsigned char *bitmap )
+void LCM_BitmapBlit( uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t background, uint8_t invert, const unsigned char *bitmap )
 {
-    uint16_t Col, Row;
-    uint16_t Byte;
-    uint8_t Bit;
-    uint8_t Pixel;
+    uint16_t Col, Page, ColEnd;
+    uint16_t Mask, Bits;
+    uint8_t  Shift, DstPage;
+    uint8_t *pDst;
 
-    // Update a Bitmap to Frame Buffer
-    for( Row = 0 ; Row < h ; Row++ )
+    if( x>=LCM_WIDTH || y>=LCM_HEIGHT ) return;
+
+    // Clip Columns out of Screen
+    ColEnd = ( x+w > LCM_WIDTH ) ? LCM_WIDTH-x : w;
+    Shift  = y%8;
+
+    // Bitmap is Page ready (8 Rows per Byte), shift each Byte across 2 Pages of Frame Buffer
+    for( Page = 0 ; Page < (h+7)/8 ; Page++ )
     {
-        for( Col = 0 ; Col < w ; Col++ )
+        DstPage = (y/8)+Page;
+        Mask    = ( h-(Page*8) >= 8 ) ? 0xFF : ((1<<(h-(Page*8)))-1);
+        Mask  <<= Shift;
+        pDst    = &LCM_pFrameBuf[(DstPage*LCM_WIDTH)+x];
+
+        for( Col = 0 ; Col < ColEnd ; Col++, pDst++ )
         {
-            Byte = Col+((int)(Row/8)*w);
-            Bit  = Row%8;
-            Pixel  = (bitmap[Byte]>>Bit)&0x1;
-            if( Pixel || (!Pixel && background) )
+            Bits = invert ? (uint8_t)~bitmap[(Page*w)+Col] : bitmap[(Page*w)+Col];
+            Bits = (Bits<<Shift)&Mask;
+
+            if( background )
             {
-                _Pixel2Bit( x+Col, y+Row, Pixel );
+                pDst[0] = (pDst[0]&~(uint8_t)Mask)|(uint8_t)Bits;
+                if( Shift && DstPage+1 < LCM_HEIGHT/8 )
+                    pDst[LCM_WIDTH] = (pDst[LCM_WIDTH]&~(uint8_t)(Mask>>8))|(uint8_t)(Bits>>8);
+            }
+            else
+            {
+                pDst[0] |= (uint8_t)Bits;
+                if( Shift && DstPage+1 < LCM_HEIGHT/8 )
+                    pDst[LCM_WIDTH] |= (uint8_t)(Bits>>8);
             }
         }
+
+        if( DstPage+1 >= LCM_HEIGHT/8 ) break;
     }
 }
 
+void LCM_Bitmap( uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t background, const unsigned char *bitmap )
+{
+    LCM_BitmapBlit( x, y, w, h, background, false, bitmap );
+}
+
 /* *****************************************************************************
  End of File
  */
@@ -49,7 +49,21 @@ extern "C" {
     // Section: Data Types
     // *****************************************************************************
     // *****************************************************************************
-
+// Display backend, moves the SSD1306 Command/Data byte stream built by LCM.c
+typedef struct {
+    bool (*Init)( void );                                  // Reset and prepare the bus
+    void (*Command)( const uint8_t *pCmd, size_t size );   // Blocking Command write (RS low)
+    bool (*Transfer)( const uint8_t *pCmd, size_t cmdSize,
+                      const uint8_t *pData, size_t dataSize ); // Command then Data (RS high), may return before done
+    bool (*IsBusy)( void );                                // Transfer still in progress
+    bool (*Failed)( void );                                // Last Transfer ended on a bus error, cleared by the call
+} LCM_BACKEND;
+
+// Backend linked with LCM.c, SSD1306 over SERCOM4 SPI by default
+#ifndef LCM_BACKEND_DEFAULT
+#define LCM_BACKEND_DEFAULT LCM_SSD1306_Backend
+#endif
+extern const LCM_BACKEND LCM_BACKEND_DEFAULT;
 
     // *****************************************************************************
     // *****************************************************************************
@@ -60,10 +74,15 @@ void LCM_SetLayerBuf( uint8_t *pLayer );
 uint8_t * LCM_GetFrameBuf( void );
 uint8_t LCM_Init( void );
 void LCM_Clean( void );
-void LCM_Update( void );
+bool LCM_Update( void );
+bool LCM_UpdateWindow( uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1 );
+bool LCM_ScrollLeft( uint8_t p0, uint8_t p1 );
+bool LCM_IsBusy( void );
+uint32_t LCM_GetFrameCount( void );
 void LCM_Pixel( uint16_t x, uint16_t y, uint8_t pixel );
 void LCM_Region( uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t pixel );
 void LCM_Bitmap( uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t background, const unsigned char *bitmap );
+void LCM_BitmapBlit( uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t background, uint8_t invert, const unsigned char *bitmap );
 
     /* Provide C++ Compatibility */
 #ifdef __cplusplus
@@ -0,0 +1,198 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    LCM_SSD1306.c
+
+  @Summary
+    SSD1306 OLED backend of LCM over SERCOM4 SPI.
+
+  @Description
+    Moves the Command/Data byte stream of LCM.c to SSD1306, Frame transfer
+    runs on DMAC Channel 0 without blocking the caller.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include "LCM.h"
+#include "app_probe.h"
+#include "peripheral/port/plib_port.h"
+#include "peripheral/sercom/spi_master/plib_sercom4_spi_master.h"
+#include "peripheral/dmac/plib_dmac.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: File Scope or Global Data                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+// TIME system service
+// SPI DRIVER
+// SERCOM SPI     : MOSI (PB10)
+// SERCOM SPI     : SCK  (PB11)
+// SERCOM SPI     : SS   (PA13)          , Hardware control
+// SSD1306_CS     : SS   (PA13)          , GPIO Output Latch high
+// SSD1306_RESET  : Reset(PA27)          , GPIO Output Latch high
+// SSD1306_RS     : A0/Data/Command(PA12), GPIO Output Latch high
+#define OLED_RESET_ENABLE  0  // Enable OLED Reset PIN on PA27
+#define OLED_CS_PIN_GPIO   1  // Enable SPI GPIO Slave Select on PA13
+#define OLED_DMA_ENABLE    1  // Enable non-blocking Frame transfer on DMAC Channel 0
+#define OLED_TXC_WAIT      1000 // Polls for last bytes to shift out in DMAC interrupt, 2 bytes at 1MHz SPI take ~80
+
+// Frame transfer phases, Command (RS low) then Data (RS high)
+typedef enum {
+    SSD1306_XFER_IDLE = 0,
+    SSD1306_XFER_COMMAND,
+    SSD1306_XFER_DATA
+} SSD1306_XFER_PHASE;
+
+volatile SSD1306_XFER_PHASE SSD1306_XferPhase = SSD1306_XFER_IDLE; // Current phase of transfer
+const uint8_t *SSD1306_pXferData = NULL; // Data of transfer, sent after Command
+size_t SSD1306_XferDataSize = 0;
+volatile bool SSD1306_XferFailed = false; // Transfer ended on DMAC error or SPI stall, GDDRAM holds part of it
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Callback Functions
+// *****************************************************************************
+// *****************************************************************************
+#if OLED_DMA_ENABLE
+// DMAC Channel 0 block complete, sequence Command phase to Data phase
+static void _SSD1306_TransferHandler( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    uint16_t Wait = OLED_TXC_WAIT;
+
+    // DMA complete means last byte is in SERCOM DATA, wait it shifted out before RS/CS change,
+    // bounded so a stalled SERCOM does not hang the interrupt
+    while( SERCOM4_SPI_IsTransmitterBusy() && --Wait );
+
+    if( event==DMAC_TRANSFER_EVENT_COMPLETE && Wait && SSD1306_XferPhase==SSD1306_XFER_COMMAND && SSD1306_XferDataSize )
+    {
+        // Data Transfer (Pixel Data)
+        SSD1306_RS_Set();
+        SSD1306_XferPhase = SSD1306_XFER_DATA;
+        DMAC_ChannelTransfer( DMAC_CHANNEL_0, SSD1306_pXferData, ( const void* )&SERCOM4_REGS->SPIM.SERCOM_DATA, SSD1306_XferDataSize );
+        return;
+    }
+
+#if OLED_CS_PIN_GPIO
+    // Chip Disable
+    SSD1306_CS_Set();
+#endif
+
+    // Frame to send again
+    if( event!=DMAC_TRANSFER_EVENT_COMPLETE || Wait==0 ) SSD1306_XferFailed = true;
+
+    SSD1306_XferPhase = SSD1306_XFER_IDLE;
+    APP_PROBE_End( APP_PROBE_SPI );
+}
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+static bool _SSD1306_Init( void )
+{
+#if OLED_RESET_ENABLE
+    // Reset Start
+    SSD1306_RESET_Clear();
+
+    // Reset Release
+    SSD1306_RESET_Set();
+#endif
+
+#if OLED_DMA_ENABLE
+    DMAC_ChannelCallbackRegister( DMAC_CHANNEL_0, _SSD1306_TransferHandler, ( uintptr_t )NULL );
+#endif
+
+    return true;
+}
+
+static bool _SSD1306_IsBusy( void )
+{
+    return ( SSD1306_XferPhase!=SSD1306_XFER_IDLE );
+}
+
+static bool _SSD1306_Failed( void )
+{
+    bool Failed = SSD1306_XferFailed;
+
+    SSD1306_XferFailed = false;
+    return Failed;
+}
+
+static void _SSD1306_Command( const uint8_t *pCmd, size_t size )
+{
+    // Let a running transfer finish, Command is blocking
+    while( _SSD1306_IsBusy() );
+
+#if OLED_CS_PIN_GPIO
+    // Chip Enable
+    SSD1306_CS_Clear();
+#endif
+
+    // Command Transfer
+    SSD1306_RS_Clear();
+    SERCOM4_SPI_Write(( void* )pCmd, size);
+
+#if OLED_CS_PIN_GPIO
+    // Chip Disable
+    SSD1306_CS_Set();
+#endif
+}
+
+static bool _SSD1306_Transfer( const uint8_t *pCmd, size_t cmdSize, const uint8_t *pData, size_t dataSize )
+{
+    if( _SSD1306_IsBusy() ) return false;
+    APP_PROBE_Begin( APP_PROBE_SPI );
+
+#if OLED_CS_PIN_GPIO
+    // Chip Enable
+    SSD1306_CS_Clear();
+#endif
+
+    // Command Transfer
+    SSD1306_RS_Clear();
+
+#if OLED_DMA_ENABLE
+    // Data phase is chained from _SSD1306_TransferHandler
+    SSD1306_pXferData    = pData;
+    SSD1306_XferDataSize = dataSize;
+    SSD1306_XferPhase    = SSD1306_XFER_COMMAND;
+    DMAC_ChannelTransfer( DMAC_CHANNEL_0, pCmd, ( const void* )&SERCOM4_REGS->SPIM.SERCOM_DATA, cmdSize );
+#else
+    SERCOM4_SPI_Write(( void* )pCmd, cmdSize);
+
+    // Data Transfer, none for Scroll only
+    SSD1306_RS_Set();
+    if( dataSize ) SERCOM4_SPI_Write(( void* )pData, dataSize);
+
+#if OLED_CS_PIN_GPIO
+    // Chip Disable
+    SSD1306_CS_Set();
+#endif
+    APP_PROBE_End( APP_PROBE_SPI );
+#endif
+
+    return true;
+}
+
+const LCM_BACKEND LCM_SSD1306_Backend = {
+    .Init     = _SSD1306_Init,
+    .Command  = _SSD1306_Command,
+    .Transfer = _SSD1306_Transfer,
+    .IsBusy   = _SSD1306_IsBusy,
+    .Failed   = _SSD1306_Failed,
+};
+
+/* *****************************************************************************
+ End of File
+ */
@@ -29,9 +29,14 @@
 #include <string.h>
 #include "main.h"
 #include "app_ecg.h"
+#include "app_memory.h"
 #include "app_oled.h"
+#include "app_probe.h"
+#include "app_telemetry.h"
 #include "GraphicLib.h"
 #include "firmware/application/sml_recognition_run.h"
+#include "firmware/application/sml_learn.h"
+#include "firmware/application/sml_blob.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -96,7 +101,7 @@ uint8_t BMD101_chksum;
 uint8_t BMD101_SignalQaulity = SENSOR_OFF;  // Signal Quality
 
 #define ECG_TAKE_SAMPLES           2000     // Take 2000 samples to calculate
-#define ECG_WAVE_UPDATE_RATE       20      // Heart Rate wave update after N new samples coming
+#define ECG_WAVE_UPDATE_RATE       20      // Heart Beat check after N new samples coming
 int16_t ECG_SampleBufferRingIdx = 0;        // ECG Raw sample buffer ring index (latest)
 int16_t ECG_SampleBuffer[ECG_TAKE_SAMPLES]; // ECG Raw sample buffer
 uint8_t ECG_HeartRate = 0;
@@ -144,8 +149,6 @@ int16_t APP_ECG_IIR( int16_t ECG_Raw )
 #define PULSE_THRESHOLD      1500
 void APP_ECG_Output( int16_t *SampleBuf, int16_t RingIdx )
 {
-    int16_t ECG_RawMin = 0x7FFF; // ECG Raw Minimum
-    int16_t ECG_RawMax = 0x8000; // ECG Raw Maximum
     int16_t ECG_WinMin = 0x7FFF; // ECG Window Minimum
     int16_t ECG_WinMax = 0x8000; // ECG Window Maximum
     int16_t ECG_WinMinIdx = 0; // ECG Window Minimum Index
@@ -153,30 +156,21 @@ void APP_ECG_Output( int16_t *SampleBuf, int16_t RingIdx )
     int16_t ECG_WinIdx = 0;
     static uint8_t ECG_WinSize = 0;
 
-    ECG_RawMin = 0x7FFF; // ECG Raw Minimum
-    ECG_RawMax = 0x8000; // ECG Raw Maximum
     ECG_WinMin = 0x7FFF; // ECG Window Minimum
     ECG_WinMax = 0x8000; // ECG Window Maximum
-    for( int j=0 ; j<ECG_TAKE_SAMPLES ; j++)
+    for( int j=0 ; j<PULSE_WINDOW ; j++)
     {
-        // Find Min and Max data in collected ECG Raw buffers for UI upper/lower boundary
-        if(ECG_RawMin>SampleBuf[j]) ECG_RawMin=SampleBuf[j];
-        if(ECG_RawMax<SampleBuf[j]) ECG_RawMax=SampleBuf[j];
-
         // Find Min and Max data in Window of ECG Raw buffers for Heart Beat sound
-        if( j<PULSE_WINDOW )
+        ECG_WinIdx = (j+RingIdx+ECG_TAKE_SAMPLES-PULSE_WINDOW)%ECG_TAKE_SAMPLES;
+        if(ECG_WinMin>SampleBuf[ECG_WinIdx])
         {
-            ECG_WinIdx = (j+RingIdx+ECG_TAKE_SAMPLES-PULSE_WINDOW)%ECG_TAKE_SAMPLES;
-            if(ECG_WinMin>SampleBuf[ECG_WinIdx])
-            {
-                ECG_WinMin=SampleBuf[ECG_WinIdx];
-                ECG_WinMinIdx=ECG_WinIdx;
-            }
-            if(ECG_WinMax<SampleBuf[ECG_WinIdx])
-            {
-                ECG_WinMax=SampleBuf[ECG_WinIdx];
-                ECG_WinMaxIdx=ECG_WinIdx;
-            }
+            ECG_WinMin=SampleBuf[ECG_WinIdx];
+            ECG_WinMinIdx=ECG_WinIdx;
+        }
+        if(ECG_WinMax<SampleBuf[ECG_WinIdx])
+        {
+            ECG_WinMax=SampleBuf[ECG_WinIdx];
+            ECG_WinMaxIdx=ECG_WinIdx;
         }
     }
 
@@ -199,14 +193,678 @@ void APP_ECG_Output( int16_t *SampleBuf, int16_t RingIdx )
             LED1_Clear();
         }
     }
-
-    APP_OLED_ECG_Wave(ECG_RawMin, ECG_RawMax, SampleBuf[RingIdx]);
 }
 
+// 1: Model window filled here, one kb_run_segment per window
+// 0: One kb_run_model per sample
+#define SML_SEGMENT_ENABLE 1
+// 1: 'k' starts monitoring, a result every SML_HOP_SIZE samples until 's'
+// 0: 'k' gives one result
+#define SML_CONTINUOUS_ENABLE 1
+// 1: Full window classified by APP_ECG_InferenceTasks() from the main loop, a stage per budget check
+// 0: Full window classified inside the parser
+#define SML_DEFER_ENABLE   1
+#define SML_TASK_BUDGET_US 2000  // CPU time of APP_ECG_InferenceTasks() per main loop pass
+// 1: Window features run by APP_ECG_InferenceTasks() once its first SML_FEATURE_SPAN samples are in,
+//    only the PME and the result are left when the hop ends
+#define SML_EARLY_ENABLE   1
+// Print inference CPU cycles per sample and per window result on console
+#define SML_CYCLES_ENABLE  0
+// 1: OLED and console show the class voted by the last SML_VOTE_WINDOWS results
+// 0: Class of each window as it comes
+#define SML_VOTE_ENABLE    1
+#define SML_VOTE_WINDOWS   5  // N, results voted on
+#define SML_VOTE_ENTER     3  // K, votes a class needs to be shown
+#define SML_VOTE_KEEP      2  // Votes the shown class needs to stay shown
+// 1: 'a'/'n' label the last window AFib/Normal, its features replace the nearest pattern of the class
+//    in the PME and the table is kept in flash, 'f' goes back to the trained patterns
+#define SML_LEARN_ENABLE   1
+// 1: 'u' takes a model parameter blob of tools/kp_host/kp_model.py as hex, a newline ends it
+#define SML_UPLOAD_ENABLE  1
+
+#if SML_CONTINUOUS_ENABLE && !SML_SEGMENT_ENABLE
+#error "SML_CONTINUOUS_ENABLE needs the SML_SEGMENT_ENABLE window"
+#endif
+#if SML_DEFER_ENABLE && !SML_SEGMENT_ENABLE
+#error "SML_DEFER_ENABLE needs the SML_SEGMENT_ENABLE window"
+#endif
+#if SML_EARLY_ENABLE && !( SML_DEFER_ENABLE && SML_FIXED_POINT )
+#error "SML_EARLY_ENABLE needs the SML_DEFER_ENABLE stages and the SML_FIXED_POINT features"
+#endif
+#if SML_VOTE_ENABLE && !SML_CONTINUOUS_ENABLE
+#error "SML_VOTE_ENABLE needs the SML_CONTINUOUS_ENABLE results"
+#endif
+#if SML_VOTE_ENABLE && ( SML_VOTE_ENTER*2<=SML_VOTE_WINDOWS || SML_VOTE_KEEP>SML_VOTE_ENTER )
+#error "SML_VOTE_ENTER must be a majority of SML_VOTE_WINDOWS and SML_VOTE_KEEP at most SML_VOTE_ENTER"
+#endif
+#if SML_CASCADE && !SML_SEGMENT_ENABLE
+#error "SML_CASCADE needs the SML_SEGMENT_ENABLE window stages"
+#endif
+#if SML_UPLOAD_ENABLE && !SML_FIXED_POINT
+#error "SML_UPLOAD_ENABLE needs the SML_FIXED_POINT path, the library reads its own tables"
+#endif
+// Profiling build (-DSML_PROFILER=1), 'p' prints where the window cycles go
+#if SML_PROFILER && !SML_DEFER_ENABLE
+#error "SML_PROFILER needs the SML_DEFER_ENABLE stages"
+#endif
+
+#if SML_CONTINUOUS_ENABLE
+#define SML_HOP_SIZE     (SML_SEGMENT_SIZE/2) // New samples per window, 50% overlap
+#else
+#define SML_HOP_SIZE     SML_SEGMENT_SIZE
+#endif
+#define SML_HISTORY_SIZE 16                   // Window results kept, power of 2
+
+#if SML_SEGMENT_ENABLE
+// Model windows, one filled by samples while the other is classified, in the library ring buffer storage
+#define  ECG_Segment APP_MemoryWindows.Segment
+uint8_t  ECG_SegmentBuf = 0;            // Window being filled
+uint16_t ECG_SegmentIdx = 0;
+#endif
+#if SML_DEFER_ENABLE
+int16_t *SML_Window = NULL;             // Full window waiting for APP_ECG_InferenceTasks()
+int32_t  SML_Stage;                     // Next stage of SML_Window
+uint32_t SML_StageCycles[SML_STAGE_DONE]; // Longest run of each stage, budget estimate
+#endif
+#if SML_EARLY_ENABLE
+int16_t *SML_Next = NULL;               // Window with its feature samples in, queued behind SML_Window
+#endif
+#if SML_PROFILER
+uint32_t SML_ProfileWindow[SML_STAGE_DONE]; // Stage cycles of the window being classified
+uint32_t SML_ProfileLast[SML_STAGE_DONE]; // Stage cycles of the last window
+uint32_t SML_ProfileSum[SML_STAGE_DONE];  // Stage cycles of all windows
+uint32_t SML_ProfileWindows = 0;
+#endif
 bool SensorInference = false;
-uint8_t UART_ReadByte[1];
+APP_ECG_RESULT SML_History[SML_HISTORY_SIZE];
+uint32_t SML_HistoryIdx = 0;            // Next entry, counts all windows since 'k'
+#if SML_VOTE_ENABLE
+APP_ECG_VOTE SML_Vote;
+#endif
+#if SML_UPLOAD_ENABLE
+bool    SML_Upload = false;             // Console bytes go to the model blob
+bool    SML_UploadOdd = false;          // High digit of a byte received
+uint8_t SML_UploadHigh;
+uint32_t SML_UploadBytes;               // Blob bytes written, a Page line after each flash page
+#endif
+uint32_t SML_HopStart;                  // CPU cycles at start of the hop
+uint32_t SML_HopCycles = 0;             // Inference cycles spent in the hop
+#if SML_CYCLES_ENABLE
+uint32_t SML_WindowCycles = 0;          // Cycles of classifying the window
+uint32_t SML_SampleCycles = 0;          // Cycles of samples without result
+uint32_t SML_SampleMax = 0;
+uint32_t SML_SampleCount = 0;
+#endif
+
+static void APP_ECG_InferenceReset( void )
+{
+    // initialize the buffer for model input
+    sml_recognition_run(NULL, 1, true);
+#if SML_SEGMENT_ENABLE
+    ECG_SegmentBuf = 0;
+    ECG_SegmentIdx = 0;
+#endif
+#if SML_DEFER_ENABLE
+    SML_Window = NULL;
+#endif
+#if SML_EARLY_ENABLE
+    SML_Next = NULL;
+#endif
+    SML_HistoryIdx = 0;
+#if SML_VOTE_ENABLE
+    memset( &SML_Vote, 0, sizeof(SML_Vote) );
+#endif
+#if SML_PROFILER
+    memset( SML_ProfileSum, 0, sizeof(SML_ProfileSum) );
+    SML_ProfileWindows = 0;
+#endif
+    SML_HopCycles = 0;
+    SML_HopStart = CPU_GetCycles();
+#if SML_CYCLES_ENABLE
+    SML_SampleCycles = SML_SampleMax = SML_SampleCount = 0;
+#endif
+}
+
+// Keep the window result and the share of CPU the hop took
+static void APP_ECG_InferenceHistory( int32_t Class, uint32_t Now )
+{
+    APP_ECG_RESULT *pResult = &SML_History[SML_HistoryIdx%SML_HISTORY_SIZE];
+    uint32_t Elapsed = Now-SML_HopStart;
+
+    pResult->Tick   = TC4_GetTickCount();
+    pResult->Class  = (int16_t)Class;
+    pResult->Duty10 = Elapsed ? (uint16_t)((uint64_t)SML_HopCycles*1000/Elapsed) : 0;
+    SML_HistoryIdx++;
+
+#if !APP_TELEMETRY_ENABLE
+    myprintf("Window %lu: duty %u.%u%%%s\r\n", SML_HistoryIdx, pResult->Duty10/10, pResult->Duty10%10,
+             pResult->Duty10>=1000 ? ", cannot keep up" : "");
+#endif
+
+    SML_HopStart = Now;
+    SML_HopCycles = 0;
+}
+
+#if SML_LEARN_ENABLE
+// Last classified window becomes a pattern of Class, in the PME and in flash
+static void APP_ECG_InferenceLearn( uint16_t Class )
+{
+    sml_cascade_stats_t Cascade;
+    int32_t Slot;
+
+    if( SML_HistoryIdx==0 )
+    {
+        myprintf("No window classified since 'k'\r\n");
+        return;
+    }
+    if( sml_blob_active()!=NULL )
+    {
+        myprintf("Learning works on the built-in model, 'u' with an empty line selects it\r\n");
+        return;
+    }
+    if( sml_cascade_stats( &Cascade ) && Cascade.last_screened )
+    {
+        myprintf("Last window classified by its rhythm alone, no features to learn\r\n");
+        return;
+    }
+    Slot = sml_learn_add( Class );
+    if( Slot<0 )
+    {
+        myprintf("No %s pattern to replace\r\n", Class==1 ? "AFib" : "Normal");
+        return;
+    }
+    // Samples arriving during the flash write may be lost, the CPU stalls on flash reads meanwhile
+    myprintf("Pattern %ld learned as %s, %s\r\n", Slot, Class==1 ? "AFib" : "Normal",
+             sml_learn_save() ? "saved" : "flash write failed");
+}
+#endif
+
+#if SML_UPLOAD_ENABLE
+// One console byte of the model blob upload, two hex digits a byte
+static void APP_ECG_Upload( uint8_t Key )
+{
+    const sml_blob_t *pBlob;
+    int32_t Result;
+    uint8_t Digit;
+
+    if( Key>='0' && Key<='9' ) Digit = Key-'0';
+    else if( Key>='a' && Key<='f' ) Digit = Key-'a'+10;
+    else if( Key>='A' && Key<='F' ) Digit = Key-'A'+10;
+    else if( Key==' ' || Key=='\t' ) return;
+    else
+    {
+        SML_Upload = false;
+        if( ( Key!='\r' && Key!='\n' ) || SML_UploadOdd )
+        {
+            sml_blob_abort();
+            myprintf("\r\nUpload aborted\r\n");
+            return;
+        }
+        // Switched between windows, the window being classified keeps its model
+        Result = sml_blob_end();
+        pBlob = sml_blob_active();
+        if( Result==0 && pBlob!=NULL )
+            myprintf("\r\nModel blob v%u, %u patterns, from the next window\r\n", pBlob->header.version, pBlob->header.patterns);
+        else if( Result==0 )
+            myprintf("\r\nBuilt-in model from the next window\r\n");
+        else
+            myprintf("\r\nModel blob %s, model unchanged\r\n", Result==-2 ? "rejected (size, CRC, version or feature layout)" : "flash write failed");
+        return;
+    }
+
+    if( !SML_UploadOdd )
+    {
+        SML_UploadHigh = Digit;
+        SML_UploadOdd = true;
+        return;
+    }
+    SML_UploadOdd = false;
+    if( !sml_blob_write( (uint8_t)( (SML_UploadHigh<<4)|Digit ) ) )
+    {
+        SML_Upload = false;
+        sml_blob_abort();
+        myprintf("\r\nModel blob larger than its flash slot\r\n");
+        return;
+    }
+    // Page in flash, the CPU stalled meanwhile; the host sends the next page only now
+    if( ++SML_UploadBytes%NVMCTRL_FLASH_PAGESIZE==0 )
+    {
+        myprintf("Page %lu\r\n", SML_UploadBytes/NVMCTRL_FLASH_PAGESIZE);
+    }
+}
+#endif
+
+#if SML_VOTE_ENABLE
+#if SML_VOTE_WINDOWS > SML_HISTORY_SIZE
+#error "SML_VOTE_WINDOWS results must fit in SML_HISTORY_SIZE"
+#endif
+// Vote of the last results with the newest one in, returns the class to show
+static int16_t APP_ECG_InferenceVote( void )
+{
+    uint8_t Votes[3] = { 0, 0, 0 };
+    uint32_t Count = SML_HistoryIdx<SML_VOTE_WINDOWS ? SML_HistoryIdx : SML_VOTE_WINDOWS;
+    int16_t Shown = SML_Vote.Class;
+    int16_t Class;
+
+    for( uint32_t i=SML_HistoryIdx-Count ; i<SML_HistoryIdx ; i++ )
+    {
+        Class = SML_History[i%SML_HISTORY_SIZE].Class;
+        if( Class==1 || Class==2 ) Votes[Class]++;
+    }
+
+    // Hysteresis, the shown class stays down to SML_VOTE_KEEP votes, another one needs SML_VOTE_ENTER
+    if( Shown!=0 && Votes[Shown]<SML_VOTE_KEEP ) Shown = 0;
+    for( Class=1 ; Class<=2 ; Class++ )
+    {
+        if( Class!=Shown && Votes[Class]>=SML_VOTE_ENTER ) Shown = Class;
+    }
+
+    SML_Vote.Tick = SML_History[(SML_HistoryIdx-1)%SML_HISTORY_SIZE].Tick;
+    SML_Vote.Windows = SML_HistoryIdx;
+    if( Shown!=SML_Vote.Class || SML_Vote.Held==0 )
+    {
+        SML_Vote.Class = Shown;
+        SML_Vote.Since = SML_Vote.Tick;
+        SML_Vote.Held = 0;
+    }
+    SML_Vote.Held++;
+    SML_Vote.Votes = Votes[Shown];
+    SML_Vote.Known = Votes[1]+Votes[2];
+
+#if !APP_TELEMETRY_ENABLE
+    if( SML_Vote.Held==1 )
+    {
+        myprintf("Vote: %s, %u of last %lu windows\r\n", Shown==1 ? "AFib" : Shown==2 ? "Normal" : "Unknown",
+                 (unsigned)( Shown ? SML_Vote.Votes : Count-SML_Vote.Known ), Count);
+    }
+#endif
+    return Shown;
+}
+#endif
+
+#if APP_TELEMETRY_ENABLE
+// Binary result record of the newest window, tools/telemetry prints it as text
+static void APP_ECG_InferenceRecord( int32_t Shown )
+{
+    const APP_ECG_RESULT *pResult = &SML_History[(SML_HistoryIdx-1)%SML_HISTORY_SIZE];
+    APP_TELEMETRY_RESULT_RECORD Record;
+    sml_result_t Result;
+
+    sml_result( &Result );
+    Record.Type      = APP_TELEMETRY_RESULT;
+    Record.Source    = Result.source;
+    Record.Class     = (int8_t)pResult->Class;
+    Record.Shown     = (int8_t)Shown;
+    Record.Tick      = pResult->Tick;
+    Record.Window    = SML_HistoryIdx;
+    Record.Duty10    = pResult->Duty10;
+    Record.Influence = Result.influence;
+    Record.Distance  = Result.distance;
+    Record.Pattern   = Result.pattern;
+    Record.Features  = APP_TELEMETRY_FEATURES ? (uint8_t)Result.features : 0;
+    APP_TELEMETRY_Send( &Record, sizeof(Record), Result.vector, Record.Features );
+}
+#endif
+
+// Class of a complete window
+static void APP_ECG_InferenceResult( int32_t Class, uint32_t Now )
+{
+    APP_ECG_InferenceHistory( Class, Now );
+#if SML_VOTE_ENABLE
+    // One window's class alone does not change what is shown
+    Class = APP_ECG_InferenceVote();
+#endif
+#if APP_TELEMETRY_ENABLE
+    APP_ECG_InferenceRecord( SML_VOTE_ENABLE ? Class : -1 );
+#endif
+
+#if SML_CYCLES_ENABLE
+    myprintf("Inference %s: sample avg %lu max %lu cycles, window %lu cycles\r\n",
+             SML_DEFER_ENABLE ? "deferred" : SML_SEGMENT_ENABLE ? "segment" : "stream",
+             SML_SampleCount ? SML_SampleCycles/SML_SampleCount : 0, SML_SampleMax, SML_WindowCycles);
+    SML_SampleCycles = SML_SampleMax = SML_SampleCount = 0;
+#endif
+
+    switch( Class )
+    {
+    case 1:  APP_OLED_ML_Inference("AFib");
+#if !APP_TELEMETRY_ENABLE
+            myprintf("AFib\r\n");
+#endif
+#if !SML_CONTINUOUS_ENABLE
+            // as the model inference complete one data, it will stop
+            SensorInference = false;
+#endif
+            break;
+    case 2:  APP_OLED_ML_Inference("Normal");
+#if !APP_TELEMETRY_ENABLE
+            myprintf("Normal\r\n");
+#endif
+#if !SML_CONTINUOUS_ENABLE
+            // as the model inference complete one data, it will stop
+            SensorInference = false;
+#endif
+            break;
+    default: // Unknown
+            break;
+    }
+}
+
+#if SML_DEFER_ENABLE
+// Hand a window to APP_ECG_InferenceTasks(), starting at Stage
+static void APP_ECG_InferenceWindow( int16_t *pWindow, int32_t Stage )
+{
+    SML_Window = pWindow;
+    SML_Stage = Stage;
+#if SML_PROFILER
+    memset( SML_ProfileWindow, 0, sizeof(SML_ProfileWindow) );
+#endif
+#if SML_CYCLES_ENABLE
+    SML_WindowCycles = 0;
+#endif
+}
+
+#if SML_EARLY_ENABLE
+// Feature samples of the window being filled are in, its features need not wait for the hop
+static void APP_ECG_InferenceEarly( void )
+{
+    if( SML_Window==NULL ) APP_ECG_InferenceWindow( ECG_Segment[ECG_SegmentBuf], SML_STAGE_FEATURES );
+    else SML_Next = ECG_Segment[ECG_SegmentBuf];
+}
+#endif
+
+// Run stages of SML_Window, within SML_TASK_BUDGET_US when Budget is set
+static void APP_ECG_InferenceStep( bool Budget )
+{
+    uint32_t Start = CPU_GetCycles();
+    uint32_t Now = Start;
+    uint32_t Cycles;
+    int32_t Stage, Result = -1;
+
+    while( SML_Window!=NULL )
+    {
+#if SML_EARLY_ENABLE
+        // Features are ready ahead of the hop, the PME (or the result of a screened window) waits until the window is full
+        if( ( SML_Stage==SML_STAGE_CLASSIFY || SML_Stage==SML_STAGE_OUTPUT ) && SML_Window==ECG_Segment[ECG_SegmentBuf] ) break;
+#endif
+        // At least one stage per pass, the next one only if its longest run still fits
+        if( Budget && Now!=Start &&
+            Now-Start+SML_StageCycles[SML_Stage] > SML_TASK_BUDGET_US*(SYSTICK_FREQ/1000000U) )
+            break;
+
+        Stage = SML_Stage;
+        Result = sml_segment_step( SML_Window, SML_SEGMENT_SIZE, &SML_Stage );
+        Cycles = CPU_GetCycles()-Now;
+        Now += Cycles;
+        if( Cycles > SML_StageCycles[Stage] ) SML_StageCycles[Stage] = Cycles;
+#if SML_PROFILER
+        SML_ProfileWindow[Stage] = Cycles;
+        if( SML_Stage==SML_STAGE_DONE )
+        {
+            for( Stage=0 ; Stage<SML_STAGE_DONE ; Stage++ ) SML_ProfileSum[Stage] += SML_ProfileWindow[Stage];
+            memcpy( SML_ProfileLast, SML_ProfileWindow, sizeof(SML_ProfileLast) );
+            SML_ProfileWindows++;
+        }
+#endif
+
+        if( SML_Stage==SML_STAGE_DONE )
+        {
+            SML_Window = NULL;
+#if SML_EARLY_ENABLE
+            // The queued window goes on with its features, from the next pass once there is a result
+            if( SML_Next!=NULL ) APP_ECG_InferenceWindow( SML_Next, SML_STAGE_FEATURES );
+            SML_Next = NULL;
+            if( Result >= 0 ) break;
+#endif
+        }
+    }
+
+    SML_HopCycles += Now-Start;
+    APP_PROBE_Record( APP_PROBE_INFER, Now-Start );
+#if SML_CYCLES_ENABLE
+    SML_WindowCycles += Now-Start;
+#endif
+    if( Result >= 0 ) APP_ECG_InferenceResult( Result, Now );
+}
+#endif
+
+// One sample to the model window, the window is classified when full
+static void APP_ECG_InferenceRun( int16_t ECG_Signal )
+{
+    int32_t Result;
+    uint32_t Cycles = CPU_GetCycles();
+    uint32_t Now;
+#if SML_SEGMENT_ENABLE
+    int16_t *pWindow;
+#endif
+
+#if SML_SEGMENT_ENABLE
+    // A single store per sample, model runs on the full window only
+    sml_segment_sample( ECG_Signal );
+    ECG_Segment[ECG_SegmentBuf][ECG_SegmentIdx++] = ECG_Signal;
+    if( ECG_SegmentIdx < SML_SEGMENT_SIZE )
+    {
+#if SML_EARLY_ENABLE
+        if( ECG_SegmentIdx==SML_FEATURE_SPAN ) APP_ECG_InferenceEarly();
+#endif
+        Result = -1;
+    }
+    else
+    {
+#if SML_DEFER_ENABLE
+        // Previous window not done within a hop, finish it before its buffer is reused
+#if SML_EARLY_ENABLE
+        if( SML_Window!=NULL && SML_Window!=ECG_Segment[ECG_SegmentBuf] ) APP_ECG_InferenceStep( false );
+#else
+        if( SML_Window!=NULL ) APP_ECG_InferenceStep( false );
+#endif
+        Cycles = CPU_GetCycles();
+#endif
+        // Next window starts with the overlap, filling goes on in the other buffer
+        pWindow = ECG_Segment[ECG_SegmentBuf];
+        ECG_SegmentBuf ^= 1;
+        memcpy( ECG_Segment[ECG_SegmentBuf], pWindow+SML_HOP_SIZE, (SML_SEGMENT_SIZE-SML_HOP_SIZE)*sizeof(int16_t) );
+        ECG_SegmentIdx = SML_SEGMENT_SIZE-SML_HOP_SIZE;
+#if SML_EARLY_ENABLE
+        // Features of the full window are done or queued, the PME is released by the buffer swap;
+        // the overlap may already hold the feature samples of the next window
+        if( ECG_SegmentIdx>=SML_FEATURE_SPAN ) APP_ECG_InferenceEarly();
+        Result = -1;
+#elif SML_DEFER_ENABLE
+        APP_ECG_InferenceWindow( pWindow, SML_STAGE_SEGMENTATION );
+        Result = -1;
+#else
+        Result = sml_segment_run( pWindow, SML_SEGMENT_SIZE );
+#endif
+    }
+#else
+    Result = sml_recognition_run( &ECG_Signal, 1, false );
+#endif
+
+    Now = CPU_GetCycles();
+    SML_HopCycles += Now-Cycles;
+    APP_PROBE_Record( APP_PROBE_INFER, Now-Cycles );
+
+#if SML_CYCLES_ENABLE
+    Cycles = Now-Cycles;
+    if( Result < 0 )
+    {
+        SML_SampleCycles += Cycles;
+        SML_SampleCount++;
+        if( Cycles > SML_SampleMax ) SML_SampleMax = Cycles;
+    }
+    else
+    {
+        SML_WindowCycles = Cycles;
+    }
+#endif
+
+    if( Result >= 0 ) APP_ECG_InferenceResult( Result, Now );
+}
+
+#if SML_PROFILER
+// Print the stage cycles of the last window and the average of all windows
+static void APP_ECG_InferenceProfile( void )
+{
+    static const char *const StageName[SML_STAGE_DONE] = { "Segmentation", "Features", "Transform+PME", "Output" };
+    static const char *const FamilyName[SML_FAMILIES] = { "HPS", "Peak HPS", "Power spectrum" };
+    uint32_t Family[SML_FAMILIES], Classifier;
+    uint8_t i;
+
+    myprintf("Profile of %lu windows, cycles last/avg (%lu per ms)\r\n", SML_ProfileWindows, SYSTICK_FREQ/1000U);
+    if( SML_ProfileWindows==0 ) return;
+
+    for( i=0 ; i<SML_STAGE_DONE ; i++ )
+    {
+        myprintf("  %-16s %8lu %8lu\r\n", StageName[i], SML_ProfileLast[i], SML_ProfileSum[i]/SML_ProfileWindows);
+    }
+
+    // Generator and classifier split, timed by sml_recognition_run.c with SML_FIXED_POINT,
+    // by the knowledge pack itself otherwise
+    if( sml_profile_cycles( Family, &Classifier ) )
+    {
+        for( i=0 ; i<SML_FAMILIES ; i++ ) myprintf("    %-14s %8lu\r\n", FamilyName[i], Family[i]);
+        myprintf("    %-14s %8lu\r\n", "Transform",
+                 SML_ProfileLast[SML_STAGE_CLASSIFY]>Classifier ? SML_ProfileLast[SML_STAGE_CLASSIFY]-Classifier : 0);
+        myprintf("    %-14s %8lu\r\n", "Classifier", Classifier);
+    }
+    else
+    {
+        myprintf("  SML_FIXED_POINT 0 and libmplabml.a built without SML_PROFILER, no generator split\r\n");
+    }
+}
+#endif
+
+// Print the window results, oldest first
+static void APP_ECG_InferencePrint( void )
+{
+    sml_cascade_stats_t Cascade;
+    APP_ECG_RESULT History[SML_HISTORY_SIZE];
+    uint8_t Count = APP_ECG_GetHistory( History, SML_HISTORY_SIZE );
+
+    for( uint8_t i=0 ; i<Count ; i++ )
+    {
+        myprintf("%lu.%lus %s, duty %u.%u%%\r\n", History[i].Tick/10000, (History[i].Tick/1000)%10,
+                 History[i].Class==1 ? "AFib" : History[i].Class==2 ? "Normal" : "Unknown",
+                 History[i].Duty10/10, History[i].Duty10%10);
+    }
+#if SML_VOTE_ENABLE
+    if( Count )
+    {
+        myprintf("Vote %s since %lu.%lus, %lu of %lu windows, %u of last %u known\r\n",
+                 SML_Vote.Class==1 ? "AFib" : SML_Vote.Class==2 ? "Normal" : "Unknown",
+                 SML_Vote.Since/10000, (SML_Vote.Since/1000)%10, SML_Vote.Held, SML_Vote.Windows,
+                 SML_Vote.Known, SML_HistoryIdx<SML_VOTE_WINDOWS ? (unsigned)SML_HistoryIdx : SML_VOTE_WINDOWS);
+    }
+#endif
+    if( sml_cascade_stats( &Cascade ) && Cascade.windows )
+    {
+        myprintf("Cascade: %lu of %lu windows by rhythm, %lu of %lu checks disagreed with the PME\r\n",
+                 Cascade.screened, Cascade.windows, Cascade.disagreed, Cascade.audits);
+    }
+}
+
 bool buffer_init = false;
-uint16_t count = 0;
+
+#define APP_ECG_CONSOLE_SIZE 256        // Console RX ring, power of 2, holds a page of upload hex
+uint8_t  ConsoleRing[APP_ECG_CONSOLE_SIZE];
+volatile uint16_t ConsoleHead = 0;      // Bytes received, by the SERCOM5 read callback
+volatile uint16_t ConsoleTail = 0;      // Bytes taken by APP_ECG_ConsoleTasks()
+uint8_t  ConsoleByte;                   // Byte of the pending SERCOM5 read
+
+// SERCOM5 read done or failed: keep the byte, read the next one
+static void APP_ECG_ConsoleReceive( uintptr_t context )
+{
+    if( SERCOM5_USART_ErrorGet()==USART_ERROR_NONE && (uint16_t)(ConsoleHead-ConsoleTail)<APP_ECG_CONSOLE_SIZE )
+    {
+        ConsoleRing[ConsoleHead%APP_ECG_CONSOLE_SIZE] = ConsoleByte;
+        ConsoleHead++;
+    }
+    SERCOM5_USART_Read( &ConsoleByte, 1 );
+}
+
+// Console key, from APP_ECG_ConsoleTasks() whatever the sensor state
+static void APP_ECG_ConsoleKey( uint8_t Key )
+{
+    switch( Key )
+    {
+    case 'k': case 'K':
+        SensorInference = true;
+        buffer_init = true;
+        break;
+#if SML_CONTINUOUS_ENABLE
+    case 's': case 'S':
+        SensorInference = false;
+        break;
+#endif
+    case 'h': case 'H':
+        APP_ECG_InferencePrint();
+        break;
+#if SML_LEARN_ENABLE
+    case 'a': case 'A':
+        APP_ECG_InferenceLearn( 1 );
+        break;
+    case 'n': case 'N':
+        APP_ECG_InferenceLearn( 2 );
+        break;
+    case 'f': case 'F':
+        myprintf("%s\r\n", sml_learn_forget() ? "Trained patterns restored" : "Pattern store erase failed");
+        break;
+#endif
+#if SML_UPLOAD_ENABLE
+    case 'u': case 'U':
+        if( sml_blob_begin() )
+        {
+            SML_Upload = true;
+            SML_UploadOdd = false;
+            SML_UploadBytes = 0;
+            // Paced by the host, a page of hex after each Page line (tools/kp_host/kp_upload.py)
+            myprintf("\r\nSend the model blob hex, %u digits after each Page line, and a newline;"
+                     " an empty line for the built-in model\r\nPage 0\r\n", 2*NVMCTRL_FLASH_PAGESIZE);
+        }
+        else
+        {
+            myprintf("\r\nModel slot still read by the window being classified, retry\r\n");
+        }
+        break;
+#endif
+#if SML_PROFILER
+    case 'p': case 'P':
+        APP_ECG_InferenceProfile();
+        break;
+#endif
+#if APP_PROBE_ENABLE
+    case 't': case 'T':
+        APP_PROBE_Print();
+        break;
+#endif
+    }
+}
+
+// Console bytes received since the last pass, a model blob upload or keys
+static void APP_ECG_ConsoleTasks( void )
+{
+    uint8_t Key;
+
+    while( ConsoleTail!=ConsoleHead )
+    {
+        Key = ConsoleRing[ConsoleTail%APP_ECG_CONSOLE_SIZE];
+        ConsoleTail++;
+#if SML_UPLOAD_ENABLE
+        // Not echoed, the uploader waits for the Page lines
+        if( SML_Upload )
+        {
+            APP_ECG_Upload( Key );
+            continue;
+        }
+#endif
+        // Echo UART input
+        SERCOM5_USART_Write( &Key, 1 );
+        while( SERCOM5_USART_WriteIsBusy() ) {}
+        APP_ECG_ConsoleKey( Key );
+    }
+}
+
 void BMD101_CODE_Parser( uint8_t *pPayload, uint8_t Length )
 {
     int i;
@@ -271,62 +929,24 @@ void BMD101_CODE_Parser( uint8_t *pPayload, uint8_t Length )
                        
                     if( BMD101_SignalQaulity == SENSOR_ON )
                     {
-                        //start the inference once it get the triggered signal('k')
-                        if(SERCOM5_USART_Read(UART_ReadByte, 1))
-                        {
-                            // Echo UART input
-                            SERCOM5_USART_Write(UART_ReadByte, 1);
-                            while( SERCOM5_USART_WriteIsBusy() ) {}
-                            // Check key-in byte
-                            switch( UART_ReadByte[0] )
-                            {
-                            case 'k': case 'K':
-                                SensorInference = true;
-                                buffer_init = true;
-                                break;
-                            }
-                        }
                         // inference control
                         if(SensorInference==true)
                         {
                             if(buffer_init==true)
                             {
                                 // initialize the buffer for model input
-                                sml_recognition_run(&ECG_Signal, 1, buffer_init);
+                                APP_ECG_InferenceReset();
                                 buffer_init = false;
                                 
                                 // Start the Inference Interval Timer.
                                 TC4_DelayMS( INFERENCE_INTERVAL, DELAY_TIMER_INFERENCE_INTERVAL );
-                                // Start the 5s Interval Timer.
-                                TC4_DelayMS( five_sec_INTERVAL, DELAY_TIMER_5_sec_INTERVAL );
                             }
                             else
                             {
-                                if(TC4_DelayIsComplete( DELAY_TIMER_5_sec_INTERVAL))
-                                {
-                                    myprintf("%d\r\n",count);
-                                    count = 0;
-                                }
                                 if(TC4_DelayIsComplete( DELAY_TIMER_INFERENCE_INTERVAL))
                                 {
-                                    count = count + 1;
-                                    
-                                    // send one data point to the model for accumulation, as the data accumulate as many as model input, it will return 0 or 1, otherwise, it will return negative value 
-                                    switch( sml_recognition_run(&ECG_Signal, 1, buffer_init) )
-                                    {
-                                    case 1:  APP_OLED_ML_Inference("AFib"); 
-                                            myprintf("AFib\r\n");
-                                            // as the model inference complete one data, it will stop
-                                            SensorInference = false;
-                                            break;
-                                    case 2:  APP_OLED_ML_Inference("Normal");
-                                            myprintf("Normal\r\n");
-                                            // as the model inference complete one data, it will stop
-                                            SensorInference = false;
-                                            break;
-                                    default: //when data points accumulation is not sufficient for model input, it will do nothing
-                                            break;
-                                    }
+                                    // send one data point to the model for accumulation, as the data accumulate as many as model input, APP_ECG_InferenceResult() gets the class
+                                    APP_ECG_InferenceRun( ECG_Signal );
                                     // Re-Start the Inference Interval Timer.
                                     TC4_DelayMS( INFERENCE_INTERVAL, DELAY_TIMER_INFERENCE_INTERVAL );
                                 }
@@ -334,17 +954,24 @@ void BMD101_CODE_Parser( uint8_t *pPayload, uint8_t Length )
                         }
                             
                         // Select Filter Type
+                        APP_PROBE_Begin( APP_PROBE_FILTER );
                         if     ( VR1_Pos<=1 ) { ECG_RawFiltered = ECG_Signal; } // No Filter
                         else if( VR1_Pos>=4 ) { ECG_RawFiltered = APP_ECG_MovingAverage( ECG_Signal ); } // Moving Average
                         else                  { ECG_RawFiltered = APP_ECG_IIR( ECG_Signal ); } // IIR Filter
+                        APP_PROBE_End( APP_PROBE_FILTER );
                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                            
                         // Move in new Filtered ECG data to end of ring buffer
                         ECG_SampleBuffer[ECG_SampleBufferRingIdx]=ECG_RawFiltered;
 
-                        // Output Heart Beat sound and Wave UI in interval of ECG_WAVE_UPDATE_RATE
+                        // Wave UI buckets, drawn by OLED render task at its Frame rate
+                        APP_OLED_ECG_WaveSample( ECG_RawFiltered );
+
+                        // Output Heart Beat sound in interval of ECG_WAVE_UPDATE_RATE
                         if( ECG_SampleBufferRingIdx%ECG_WAVE_UPDATE_RATE==0 )
                         {
+                            APP_PROBE_Begin( APP_PROBE_DETECT );
                             APP_ECG_Output( ECG_SampleBuffer, ECG_SampleBufferRingIdx );
+                            APP_PROBE_End( APP_PROBE_DETECT );
                         }
 
                         // Increase Ring Index
@@ -378,6 +1005,76 @@ void BMD101_CODE_Parser( uint8_t *pPayload, uint8_t Length )
     } // for( i=0 ; i<Length ; i++ )
 }
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void APP_ECG_InferenceTasks ( void )
+
+  Remarks:
+    See prototype in app_ecg.h.
+ */
+
+void APP_ECG_InferenceTasks ( void )
+{
+#if SML_DEFER_ENABLE
+    if( SML_Window!=NULL ) APP_ECG_InferenceStep( true );
+#endif
+}
+
+/*******************************************************************************
+  Function:
+    uint8_t APP_ECG_GetHistory( APP_ECG_RESULT *pResult, uint8_t Size )
+
+  Remarks:
+    See prototype in app_ecg.h.
+ */
+
+uint8_t APP_ECG_GetHistory( APP_ECG_RESULT *pResult, uint8_t Size )
+{
+    uint32_t Count = SML_HistoryIdx<SML_HISTORY_SIZE ? SML_HistoryIdx : SML_HISTORY_SIZE;
+    uint32_t First;
+
+    if( Count > Size ) Count = Size;
+    First = SML_HistoryIdx-Count;
+    for( uint32_t i=0 ; i<Count ; i++ )
+    {
+        pResult[i] = SML_History[(First+i)%SML_HISTORY_SIZE];
+    }
+
+    return (uint8_t)Count;
+}
+
+/*******************************************************************************
+  Function:
+    void APP_ECG_GetVote( APP_ECG_VOTE *pVote )
+
+  Remarks:
+    See prototype in app_ecg.h.
+ */
+
+void APP_ECG_GetVote( APP_ECG_VOTE *pVote )
+{
+#if SML_VOTE_ENABLE
+    *pVote = SML_Vote;
+#else
+    // Last window alone
+    memset( pVote, 0, sizeof(*pVote) );
+    if( SML_HistoryIdx )
+    {
+        pVote->Tick = pVote->Since = SML_History[(SML_HistoryIdx-1)%SML_HISTORY_SIZE].Tick;
+        pVote->Windows = SML_HistoryIdx;
+        pVote->Held = 1;
+        pVote->Class = SML_History[(SML_HistoryIdx-1)%SML_HISTORY_SIZE].Class;
+        pVote->Votes = pVote->Known = ( pVote->Class==1 || pVote->Class==2 );
+    }
+#endif
+}
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Application Initialization and State Machine Functions
@@ -397,6 +1094,10 @@ void APP_ECG_Initialize ( void )
 {
     /* Place the App state machine in its initial state. */
     app_ecgData.state = APP_ECG_STATE_INIT;
+
+    // Console keys go to a ring from the interrupt, read whatever the sensor state
+    SERCOM5_USART_ReadCallbackRegister( APP_ECG_ConsoleReceive, (uintptr_t)NULL );
+    SERCOM5_USART_Read( &ConsoleByte, 1 );
 }
 
 /******************************************************************************
@@ -425,12 +1126,15 @@ void APP_ECG_Tasks ( void )
         break;
 
     case APP_ECG_STATE_DATA_READ:
+        APP_ECG_ConsoleTasks();
+
         // Read current RX buffer
         memset( UartReadBuffer, 0, sizeof(UartReadBuffer) );
         UartReadSize = SERCOM2_USART_Read(UartReadBuffer, SERCOM2_USART_ReadCountGet());
         if( UartReadSize )
         {
             UartRingTailSize = sizeof(UartRingBuffer)-UartRingLast;
+            APP_PROBE_Mark( APP_PROBE_UART );
 #if DEBUG_ENABLE
             myprintf("\033[1;1HRX=%04d, Last=%04d, Tail=%04d", UartReadSize, UartRingLast, UartRingTailSize );
 #endif
@@ -494,7 +1198,9 @@ void APP_ECG_Tasks ( void )
                     if( BMD101_chksum == UartRingBuffer[UartRingLast] )
                     {
                         // Parser the Payload CODEs and display GUI
+                        APP_PROBE_Begin( APP_PROBE_PARSE );
                         BMD101_CODE_Parser( BMD101_payload, BMD101_pLength );
+                        APP_PROBE_End( APP_PROBE_PARSE );
                     }
 #if DEBUG_ENABLE
                     else
@@ -83,6 +83,55 @@ typedef struct
 
 } APP_ECG_DATA;
 
+// *****************************************************************************
+/* Inference window result
+
+  Summary:
+    Result of one classified model window
+
+  Description:
+    Kept in a history ring by continuous monitoring, one entry per hop.
+
+  Remarks:
+    Duty10 is the CPU share of inference over the hop in 0.1%, 1000 or more
+    means inference cannot keep up with the sample rate.
+ */
+
+typedef struct
+{
+    uint32_t Tick;    // TC4 tick count of the result
+    int16_t  Class;   // 0 Unknown, 1 AFib, 2 Normal
+    uint16_t Duty10;  // Inference CPU share of the hop, 0.1%
+
+} APP_ECG_RESULT;
+
+// *****************************************************************************
+/* Voted inference result
+
+  Summary:
+    Class shown for the latest window results
+
+  Description:
+    A class is taken when it has SML_VOTE_ENTER of the last SML_VOTE_WINDOWS
+    results and kept down to SML_VOTE_KEEP, Unknown windows vote for no class.
+
+  Remarks:
+    Class is 0 Unknown until a class holds the vote, and again once the shown
+    class loses it without another one taking over.
+ */
+
+typedef struct
+{
+    uint32_t Since;   // TC4 tick count of the window Class was taken at
+    uint32_t Tick;    // TC4 tick count of the last window voted on
+    uint32_t Windows; // Windows voted on since 'k'
+    uint32_t Held;    // Windows Class has been shown
+    int16_t  Class;   // 0 Unknown, 1 AFib, 2 Normal
+    uint8_t  Votes;   // Results of Class in the last SML_VOTE_WINDOWS
+    uint8_t  Known;   // Results other than Unknown in the last SML_VOTE_WINDOWS
+
+} APP_ECG_VOTE;
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -164,6 +213,57 @@ void APP_ECG_Initialize ( void );
 
 void APP_ECG_Tasks( void );
 
+
+/*******************************************************************************
+  Function:
+    void APP_ECG_InferenceTasks ( void )
+
+  Summary:
+    Classifies the last full model window off the parser path.
+
+  Description:
+    Runs the segmentation, feature generation and classification stages of a
+    full window, as many as fit in the time budget of one pass. A stage is
+    not split, a pass runs at least one.
+
+  Remarks:
+    Call from the main loop.
+ */
+
+void APP_ECG_InferenceTasks ( void );
+
+
+/*******************************************************************************
+  Function:
+    uint8_t APP_ECG_GetHistory( APP_ECG_RESULT *pResult, uint8_t Size )
+
+  Summary:
+    Copies the latest window results, oldest first.
+
+  Parameters:
+    pResult - Buffer for up to Size results
+    Size    - Entries of pResult
+
+  Returns:
+    Number of results copied, the history is cleared by 'k'.
+ */
+
+uint8_t APP_ECG_GetHistory( APP_ECG_RESULT *pResult, uint8_t Size );
+
+
+/*******************************************************************************
+  Function:
+    void APP_ECG_GetVote( APP_ECG_VOTE *pVote )
+
+  Summary:
+    Copies the class voted by the latest window results.
+
+  Parameters:
+    pVote - Voted result, all zero before the first window after 'k'
+ */
+
+void APP_ECG_GetVote( APP_ECG_VOTE *pVote );
+
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
 }
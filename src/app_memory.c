@@ -0,0 +1,44 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    app_memory.c
+
+  @Summary
+    Shared static buffers of the ECG, display and ML code.
+
+  @Description
+    Storage of the views in app_memory.h.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include "app_memory.h"
+
+#if SML_FIXED_POINT && SML_FIXED_SPAN > APP_MEMORY_KB_FFT
+#error "sml_fixed_features work area larger than the knowledge pack FFT buffer"
+#endif
+
+#if 2*SML_SEGMENT_SIZE > APP_MEMORY_KB_RING+APP_MEMORY_KB_GROWTH
+#error "model windows grow the knowledge pack ring buffer by more than APP_MEMORY_KB_GROWTH"
+#endif
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: File Scope or Global Data                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+// At least the size of the library's buffers bound to them, checked by tools/ram_report
+APP_MEMORY_WINDOWS APP_MemoryWindows __attribute__((aligned(4)));
+APP_MEMORY_SCRATCH APP_MemoryScratch __attribute__((aligned(4)));
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    app_memory.h
+
+  @Summary
+    Shared static buffers of the ECG, display and ML code.
+
+  @Description
+    Buffers that are never in use at the same time share storage, each user
+    reads it through its own view. tools/ram_report prints the RAM map of a
+    build and the headroom left for the stack.
+ */
+/* ************************************************************************** */
+
+#ifndef _APP_MEMORY_H    /* Guard against multiple inclusion */
+#define _APP_MEMORY_H
+
+#include "definitions.h"
+#include "firmware/application/sml_recognition_run.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /* ************************************************************************** */
+    /* ************************************************************************** */
+    /* Section: Constants                                                         */
+    /* ************************************************************************** */
+    /* ************************************************************************** */
+#define APP_MEMORY_KB_RING   2048 // Samples of the knowledge pack ring buffer, RAW_DATA_BUFFER_0 of kb.o
+#define APP_MEMORY_KB_FFT    512  // Samples of the knowledge pack FFT buffer, sortedData of kb.o
+#define APP_MEMORY_KB_GROWTH 448  // Samples the model windows run past the ring, RAW_DATA_BUFFER_0 grows by 896 bytes
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Data Types
+    // *****************************************************************************
+    // *****************************************************************************
+// Model windows. The library only fills its ring buffer in kb_run_model, a window
+// handed to kb_add_segment is used where it is. The two windows (4992 bytes) are
+// larger than the ring (4096 bytes), so sharing saves 4096 bytes, not 4992.
+typedef union
+{
+    int16_t Segment[2][SML_SEGMENT_SIZE]; // SML_SEGMENT_ENABLE: window filled and window classified, app_ecg.c
+    int16_t Ring[APP_MEMORY_KB_RING];     // SML_SEGMENT_ENABLE 0: kb_run_model ring buffer
+} APP_MEMORY_WINDOWS;
+
+// Scratch of one inference stage, the stages of a window run one after the other
+typedef union
+{
+    int16_t Fft[APP_MEMORY_KB_FFT];     // SML_STAGE_FEATURES: library feature generation or sml_fixed_features
+} APP_MEMORY_SCRATCH;
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Interface Functions
+    // *****************************************************************************
+    // *****************************************************************************
+// The project's linker symbols bind the library's RAW_DATA_BUFFER_0 to
+// APP_MemoryWindows and its sortedData to APP_MemoryScratch (--defsym).
+// tools/ram_report checks the library's sizes against these after the link.
+extern APP_MEMORY_WINDOWS APP_MemoryWindows;
+extern APP_MEMORY_SCRATCH APP_MemoryScratch;
+
+    /* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _APP_MEMORY_H */
+
+/* *****************************************************************************
+ End of File
+ */
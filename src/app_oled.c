@@ -33,6 +33,8 @@
 #include "Microchip_Logo.h"
 #include "CString.h"
 #include "GraphicLib.h"
+#include "app_ecg.h"
+#include "app_probe.h"
 
 // *****************************************************************************
 /* Application Data
@@ -58,9 +60,28 @@ APP_OLED_DATA app_oledData;
 #define LCM_ROW               8    // LCM Text Row count
 #define LCM_COL               18   // LCM Text Column count
 
+// Print APP_OLED_ECG_HeartRate() redraw time in CPU cycles on console, SysTick as cycle source
+#define OLED_BENCHMARK_ENABLE 0
+
+// Render task, Frames on fixed TC4 tick grid of OLED_FRAME_RATE
+#define OLED_FRAME_TICKS        (10000/OLED_FRAME_RATE) // Frame period in TC4 ticks (100us)
+#define OLED_STATS_TICKS        10000                   // Frame statistics period, 1s
+#define OLED_CYCLES_PER_US      (SYSTICK_FREQ/1000000U) // CPU_GetCycles() per us, render time
+#define OLED_STATS_PRINT_ENABLE 0                       // Print Frame statistics on console each period
+#define OLED_LONG_PRESS_TICKS   10000                   // BT2 held 1s or longer
+#define OLED_DEBOUNCE_TICKS     200                     // BT2 released sooner is contact bounce
+
 int8_t LogoX, LogoY;
 bool UI_Language = UI_CHINESE; // 0: English, 1:Chinese (BT2 to toogle)
 
+// String Layer Widgets, repainted on change only
+GPL_WIDGET UI_Detect;    // Sensor detect message
+GPL_WIDGET UI_HR_Label;  // Heart Rate label
+GPL_WIDGET UI_HR_Value;  // Heart Rate digits
+GPL_WIDGET UI_HR_Unit;   // Heart Rate unit
+GPL_WIDGET UI_Filter;    // Filter type
+GPL_WIDGET UI_Inference; // AI/ML result
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Application Callback Functions
@@ -82,135 +103,319 @@ APP_OLED_LANG_ID APP_OLED_Get_Language( void )
 // ****************************************************************************
 void APP_OLED_ECG_Detect( uint8_t SignalQaulity )
 {
-    char OutStr[20];
-
-    GPL_LayerClean( LAYER_STRING );
-
     if( SignalQaulity==0 )
     {
-        GPL_LayerSet( LAYER_STRING );
+        // Sensor off, message alone on String Layer
+        GPL_WidgetHide( &UI_HR_Label );
+        GPL_WidgetHide( &UI_HR_Value );
+        GPL_WidgetHide( &UI_HR_Unit );
+        GPL_WidgetHide( &UI_Filter );
+        GPL_WidgetHide( &UI_Inference );
+
+        GPL_WidgetPlace( &UI_Detect, LAYER_STRING, LCM_CENTER_X, 0, GPL_ALIGN_CENTER );
         if( UI_Language == UI_CHINESE )
-            GPL_DrawBitmap((LCM_WIDTH-78)/2, 0, 78, 16, BG_SOLID, CString1);
+            GPL_WidgetBitmap( &UI_Detect, 78, 16, CString1 );
         else if( UI_Language == UI_ENGLISH )
-        {
-            sprintf( OutStr, "Put your Finger on" );
-            GPL_DrawString((LCM_WIDTH-(strlen(OutStr)*FONT_WIDTH))/2, 0, OutStr, BG_SOLID, TEXT_NORMAL);
-        }
+            GPL_WidgetText( &UI_Detect, "Put your Finger on" );
+    }
+    else
+    {
+        GPL_WidgetHide( &UI_Detect );
     }
 }
 
 void APP_OLED_ECG_HeartRate( int16_t nHR )
 {
-    char OutStr[20];
+    static int8_t Language = -1;
+#if OLED_BENCHMARK_ENABLE
+    static uint32_t MaxCycles = 0;
+    uint32_t Cycles = CPU_GetCycles();
+#endif
 
-    GPL_LayerClean( LAYER_STRING );
-    GPL_LayerSet( LAYER_STRING );
+    GPL_WidgetHide( &UI_Detect );
+
+    // Result shares rows with Unit bitmap, paint Unit again over it
+    if( GPL_WidgetHide( &UI_Inference ) )
+        GPL_WidgetHide( &UI_HR_Unit );
+
+    if( Language != UI_Language )
+    {
+        // Language changed, move all first, then paint
+        Language = UI_Language;
+        if( UI_Language == UI_CHINESE )
+        {
+            GPL_WidgetPlace( &UI_HR_Label, LAYER_STRING,  0, 0, GPL_ALIGN_LEFT );
+            GPL_WidgetPlace( &UI_HR_Value, LAYER_STRING, 56, 0, GPL_ALIGN_LEFT );
+            GPL_WidgetPlace( &UI_HR_Unit,  LAYER_STRING, 86, 0, GPL_ALIGN_LEFT );
+        }
+        else
+        {
+            GPL_WidgetPlace( &UI_HR_Label, LAYER_STRING,  0, 0, GPL_ALIGN_LEFT );
+            GPL_WidgetPlace( &UI_HR_Value, LAYER_STRING, 7*FONT_WIDTH, 0, GPL_ALIGN_LEFT );
+            GPL_WidgetPlace( &UI_HR_Unit,  LAYER_STRING, 10*FONT_WIDTH, 0, GPL_ALIGN_LEFT );
+        }
+        GPL_WidgetHide( &UI_HR_Label );
+        GPL_WidgetHide( &UI_HR_Unit );
+        // Filter type goes over the Label, paint it again after
+        GPL_WidgetHide( &UI_Filter );
+    }
 
     if( UI_Language == UI_CHINESE )
     {
-        GPL_DrawBitmap( 0,  0, 52, 16, BG_SOLID, CString4);
-        sprintf( OutStr, "%3d", nHR );
-        GPL_DrawString(56, 0, OutStr, BG_SOLID, TEXT_NORMAL);
-        GPL_DrawBitmap(86,  0, 42, 16, BG_SOLID, CString41);
+        GPL_WidgetBitmap( &UI_HR_Label, 52, 16, CString4 );
+        GPL_WidgetBitmap( &UI_HR_Unit,  42, 16, CString41 );
     }
     else
     {
-        sprintf( OutStr, "HR   : %3d bpm", nHR );
-        GPL_DrawString(0, 0, OutStr, BG_SOLID, TEXT_NORMAL);
+        GPL_WidgetText( &UI_HR_Label, "HR   : " );
+        GPL_WidgetText( &UI_HR_Unit,  " bpm" );
     }
+    GPL_WidgetNumber( &UI_HR_Value, "%3d", nHR );
+
+#if OLED_BENCHMARK_ENABLE
+    Cycles = CPU_GetCycles()-Cycles;
+    if( Cycles > MaxCycles ) MaxCycles = Cycles;
+    myprintf("\033[6;1HHR Redraw = %06lu cycles (Max %06lu)", Cycles, MaxCycles);
+#endif
 }
 
 void APP_OLED_ECG_FilterType( uint8_t FilterType )
 {
-    char OutStr[20];
-
-    GPL_LayerSet( LAYER_STRING );
+    GPL_WidgetPlace( &UI_Filter, LAYER_STRING, 0, 13, GPL_ALIGN_LEFT );
 
-    if     ( FilterType<=1 ) { sprintf( OutStr, "No Filter" ); }
-    else if( FilterType>=4 ) { sprintf( OutStr, "Moving Avg" ); }
-    else                     { sprintf( OutStr, "IIR Filter" ); }
-    GPL_DrawString(0, 13, OutStr, BG_SOLID, TEXT_NORMAL);
+    if     ( FilterType<=1 ) { GPL_WidgetText( &UI_Filter, "No Filter" ); }
+    else if( FilterType>=4 ) { GPL_WidgetText( &UI_Filter, "Moving Avg" ); }
+    else                     { GPL_WidgetText( &UI_Filter, "IIR Filter" ); }
 }
 
-#if 1 // Scan Style
-#define ECG_WAVE_SIZE        (LCM_WIDTH)
+// Scan Style : Wave written over in place, only the Columns of new buckets go out
+// DV Style   : Wave Pages scroll a Column per Frame. With LCM_SCROLL_ENABLE the controller scrolls them (LCM_ScrollLeft)
+//              and only the new Column goes out, else the Wave Pages go out, kept clear of String layer
+#ifndef ECG_WAVE_DV_STYLE
+#define ECG_WAVE_DV_STYLE    0
+#endif
+
+#if ECG_WAVE_DV_STYLE
+#define ECG_WAVE_PAGE0       (4)                  // Pages 4-7, below Filter/Inference
+#define ECG_WAVE_HEIGHT      (LCM_HEIGHT-1-(ECG_WAVE_PAGE0*8))
+#define ECG_WAVE_ZERO        (LCM_HEIGHT-1)
+#define ECG_WAVE_SCROLL_LAG  4                    // New buckets drawn one per Frame by Scroll, more resend the Pages
+#else
 #define ECG_WAVE_HEIGHT      (LCM_HEIGHT-20)
-#define ECG_WAVE_START       (0)
 #define ECG_WAVE_ZERO        (LCM_HEIGHT)
-void APP_OLED_ECG_Wave( int16_t ECG_min, int16_t ECG_max, int16_t ECG_data )
+#endif
+
+// Min/max pyramid, one level per sweep, each a ring of one bucket per Column
+#define ECG_WAVE_LEVELS      APP_OLED_SWEEP_MAX // 1x, 4x, 16x, 64x
+#define ECG_WAVE_BUCKET      8                  // Samples per 1x bucket, 128 Columns = 2s at 512Hz
+#define ECG_WAVE_RATIO       4                  // Buckets merged into one of next level
+#define ECG_WAVE_COLS        (LCM_WIDTH+1)      // Shown Columns and the one before oldest
+
+typedef struct {
+    int16_t Lo[ECG_WAVE_COLS];  // Bucket ring, raw ECG min/max
+    int16_t Hi[ECG_WAVE_COLS];
+    int16_t FillLo, FillHi;     // Bucket being filled
+    uint8_t Fill;               // Inputs in bucket being filled
+    uint8_t Idx;                // Next bucket of ring
+    uint8_t Pos;                // Scan Column of next bucket
+    uint8_t New;                // Buckets completed since last draw
+} ECG_WAVE_LEVEL;
+
+ECG_WAVE_LEVEL ECG_Wave[ECG_WAVE_LEVELS];
+uint8_t ECG_WaveSweep = APP_OLED_SWEEP_2S; // Level on Screen
+int16_t ECG_WaveMin = 0;                   // Range of drawn Wave, redraw all when it changes
+int16_t ECG_WaveMax = -1;
+
+void APP_OLED_ECG_WaveSample( int16_t ECG_data )
 {
-    static uint8_t RingIdx = 0;
-    static uint8_t ECG_Wave[ECG_WAVE_SIZE];
+    ECG_WAVE_LEVEL *pLevel = ECG_Wave;
+    int16_t Lo = ECG_data, Hi = ECG_data;
+    uint8_t Size = ECG_WAVE_BUCKET;
 
-    GPL_LayerClean( LAYER_GRAPHIC );
-    GPL_LayerSet( LAYER_GRAPHIC );
-    GPL_SetPenSize( 1 );
+    // Fold into bucket of each level, a completed bucket carries on to next level,
+    // drawing is up to render task
+    for( int Level=0 ; Level<ECG_WAVE_LEVELS ; Level++, pLevel++ )
+    {
+        if( pLevel->Fill==0 || Lo < pLevel->FillLo ) pLevel->FillLo = Lo;
+        if( pLevel->Fill==0 || Hi > pLevel->FillHi ) pLevel->FillHi = Hi;
+        if( ++pLevel->Fill < Size ) return;
+
+        Lo = pLevel->FillLo;
+        Hi = pLevel->FillHi;
+        pLevel->Lo[pLevel->Idx] = Lo;
+        pLevel->Hi[pLevel->Idx] = Hi;
+        pLevel->Idx  = (pLevel->Idx+1)%ECG_WAVE_COLS;
+        pLevel->Pos  = (pLevel->Pos+1)%LCM_WIDTH;
+        pLevel->Fill = 0;
+        if( pLevel->New < LCM_WIDTH ) pLevel->New++;
+        Size = ECG_WAVE_RATIO;
+    }
+}
 
-    ECG_Wave[RingIdx]  = (ECG_data-ECG_min)*ECG_WAVE_HEIGHT/(ECG_max-ECG_min+1);
-    if( ECG_Wave[RingIdx]> ECG_WAVE_HEIGHT ) ECG_Wave[RingIdx] = ECG_WAVE_HEIGHT;
-    if( ECG_Wave[RingIdx]< 0               ) ECG_Wave[RingIdx] = 0;
-
-#if 0
-    // Find Peak
-    if( ECG_Wave[RingIdx]-ECG_Wave[((RingIdx-2)+ECG_WAVE_SIZE)%ECG_WAVE_SIZE] >  8 &&
-        ECG_Wave[RingIdx]-ECG_Wave[((RingIdx-1)+ECG_WAVE_SIZE)%ECG_WAVE_SIZE] >  4 &&
-        ECG_Wave[RingIdx]-ECG_Wave[((RingIdx+1)+ECG_WAVE_SIZE)%ECG_WAVE_SIZE] >  4 &&
-        ECG_Wave[RingIdx]-ECG_Wave[((RingIdx+2)+ECG_WAVE_SIZE)%ECG_WAVE_SIZE] >  8 )
-        LED1_Set();
-    // Find Valley
-    if( ECG_Wave[RingIdx]-ECG_Wave[((RingIdx-2)+ECG_WAVE_SIZE)%ECG_WAVE_SIZE] < -8 &&
-        ECG_Wave[RingIdx]-ECG_Wave[((RingIdx-1)+ECG_WAVE_SIZE)%ECG_WAVE_SIZE] < -4 &&
-        ECG_Wave[RingIdx]-ECG_Wave[((RingIdx+1)+ECG_WAVE_SIZE)%ECG_WAVE_SIZE] < -4 &&
-        ECG_Wave[RingIdx]-ECG_Wave[((RingIdx+2)+ECG_WAVE_SIZE)%ECG_WAVE_SIZE] < -8 )
-        LED1_Clear();
-#endif
+void APP_OLED_ECG_WaveSweep( APP_OLED_SWEEP sweep )
+{
+    if( sweep >= APP_OLED_SWEEP_MAX || sweep == ECG_WaveSweep ) return;
+
+    // Level is kept up to date all along, redraw it whole at next Frame
+    ECG_WaveSweep = sweep;
+    ECG_Wave[sweep].New = LCM_WIDTH;
+}
+
+static uint8_t _APP_OLED_ECG_WaveY( int16_t ECG_data )
+{
+    int32_t Y = (int32_t)(ECG_data-ECG_WaveMin)*ECG_WAVE_HEIGHT/(ECG_WaveMax-ECG_WaveMin+1);
+
+    if( Y > ECG_WAVE_HEIGHT ) Y = ECG_WAVE_HEIGHT;
+    if( Y < 0               ) Y = 0;
+    return Y;
+}
 
-    for( int Col=0 ; Col<ECG_WAVE_SIZE-1 ; Col++ )
+static void _APP_OLED_ECG_WaveRange( const ECG_WAVE_LEVEL *pLevel, int16_t *pMin, int16_t *pMax )
+{
+    *pMin = pLevel->Lo[0];
+    *pMax = pLevel->Hi[0];
+    for( int Col=1 ; Col<ECG_WAVE_COLS ; Col++ )
     {
-        GPL_DrawLine(ECG_WAVE_START+Col, ECG_WAVE_ZERO-ECG_Wave[Col], ECG_WAVE_START+Col+1, ECG_WAVE_ZERO-ECG_Wave[Col+1]);
+        if( *pMin > pLevel->Lo[Col] ) *pMin = pLevel->Lo[Col];
+        if( *pMax < pLevel->Hi[Col] ) *pMax = pLevel->Hi[Col];
     }
+}
 
-    // Move to next buffer
-    RingIdx = (RingIdx+1)%ECG_WAVE_SIZE;
+// Bucket Age (0 for latest) at Column x
+static void _APP_OLED_ECG_WaveColumn( const ECG_WAVE_LEVEL *pLevel, uint8_t x, uint8_t Age )
+{
+    uint8_t Cur = (pLevel->Idx+ECG_WAVE_COLS-1-Age)%ECG_WAVE_COLS;
+    uint8_t Pre = (Cur+ECG_WAVE_COLS-1)%ECG_WAVE_COLS;
+    uint8_t Lo = _APP_OLED_ECG_WaveY( pLevel->Lo[Cur] );
+    uint8_t Hi = _APP_OLED_ECG_WaveY( pLevel->Hi[Cur] );
+    uint8_t PreLo = _APP_OLED_ECG_WaveY( pLevel->Lo[Pre] );
+    uint8_t PreHi = _APP_OLED_ECG_WaveY( pLevel->Hi[Pre] );
+
+    // Stretch the span to meet previous bucket, trace stays connected
+    if( PreHi < Lo ) Lo = PreHi;
+    if( PreLo > Hi ) Hi = PreLo;
+    GPL_DrawLine( x, ECG_WAVE_ZERO-Hi, x, ECG_WAVE_ZERO-Lo );
 }
-#else // DV Style
-#define ECG_WAVE_SIZE        (LCM_WIDTH)
-#define ECG_WAVE_HEIGHT      (LCM_HEIGHT-20)
-#define ECG_WAVE_START       (LCM_WIDTH)
-#define ECG_WAVE_ZERO        (LCM_HEIGHT)
-void APP_OLED_ECG_Wave( int16_t ECG_min, int16_t ECG_max, int16_t ECG_data )
+
+#if ECG_WAVE_DV_STYLE
+#define ECG_WAVE_X( pLevel, Age )  (LCM_WIDTH-1-(Age))
+#else
+#define ECG_WAVE_X( pLevel, Age )  (((pLevel)->Pos+LCM_WIDTH-1-(Age))%LCM_WIDTH)
+#endif
+
+static void _APP_OLED_ECG_WaveDraw( void )
 {
-    static uint8_t RingIdx = 0;
-    static int16_t ECG_Wave[ECG_WAVE_SIZE];
-    uint8_t CurIdx, PreIdx;
+    ECG_WAVE_LEVEL *pLevel = &ECG_Wave[ECG_WaveSweep];
+    int16_t ECG_min, ECG_max;
+    uint8_t New = pLevel->New;
+    uint8_t Age;
+
+    pLevel->New = 0;
+    _APP_OLED_ECG_WaveRange( pLevel, &ECG_min, &ECG_max );
 
-    GPL_LayerClean( LAYER_GRAPHIC );
     GPL_LayerSet( LAYER_GRAPHIC );
     GPL_SetPenSize( 1 );
 
-    ECG_Wave[RingIdx]  = (ECG_data-ECG_min)*ECG_WAVE_HEIGHT/(ECG_max-ECG_min+1);
-    if( ECG_Wave[RingIdx]> ECG_WAVE_HEIGHT ) ECG_Wave[RingIdx] = ECG_WAVE_HEIGHT;
-    if( ECG_Wave[RingIdx]< 0               ) ECG_Wave[RingIdx] = 0;
-
-    for( int Col=0 ; Col<ECG_WAVE_SIZE-1 ; Col++ )
+    if( ECG_min==ECG_WaveMin && ECG_max==ECG_WaveMax && New < LCM_WIDTH )
     {
-        CurIdx = (RingIdx-Col+ECG_WAVE_SIZE)%ECG_WAVE_SIZE;
-        PreIdx = (RingIdx-1-Col+ECG_WAVE_SIZE)%ECG_WAVE_SIZE;
-        GPL_DrawLine(ECG_WAVE_START-Col, ECG_WAVE_ZERO-ECG_Wave[CurIdx], ECG_WAVE_START-Col-1, ECG_WAVE_ZERO-ECG_Wave[PreIdx]);
+        // Same scale, only the Columns of new buckets
+#if ECG_WAVE_DV_STYLE
+        if( New <= ECG_WAVE_SCROLL_LAG )
+        {
+            // Oldest new bucket by one Column Scroll, the most per Frame, the rest at next Frames
+            pLevel->New = New-1;
+            GPL_ScrollLeft( ECG_WAVE_PAGE0, (LCM_HEIGHT/8)-1, 1 );
+            GPL_ClearRect( LCM_WIDTH-1, ECG_WAVE_ZERO-ECG_WAVE_HEIGHT, 1, ECG_WAVE_HEIGHT );
+            _APP_OLED_ECG_WaveColumn( pLevel, LCM_WIDTH-1, New-1 );
+            return;
+        }
+        // Further behind, the Wave Pages go out again and catch up
+        GPL_ScrollLeft( ECG_WAVE_PAGE0, (LCM_HEIGHT/8)-1, New );
+#endif
+        for( Age=0 ; Age<New ; Age++ )
+        {
+            GPL_ClearRect( ECG_WAVE_X( pLevel, Age ), ECG_WAVE_ZERO-ECG_WAVE_HEIGHT, 1, ECG_WAVE_HEIGHT );
+            _APP_OLED_ECG_WaveColumn( pLevel, ECG_WAVE_X( pLevel, Age ), Age );
+        }
+        return;
     }
 
-    // Move to next buffer
-    RingIdx = (RingIdx+1)%ECG_WAVE_SIZE;
+    ECG_WaveMin = ECG_min;
+    ECG_WaveMax = ECG_max;
+    GPL_LayerClean( LAYER_GRAPHIC );
+    for( Age=0 ; Age<LCM_WIDTH ; Age++ )
+    {
+        _APP_OLED_ECG_WaveColumn( pLevel, ECG_WAVE_X( pLevel, Age ), Age );
+    }
 }
-#endif
 
 // ****************************************************************************
 //  AI/ML GUI
 // ****************************************************************************
 void APP_OLED_ML_Inference( char *OutStr )
 {
-    GPL_LayerSet( LAYER_STRING );
-    GPL_DrawString((LCM_WIDTH-strlen(OutStr)*7), 25-FONT_HEIGHT_REAL, OutStr, BG_SOLID, TEXT_NORMAL);
+    GPL_WidgetPlace( &UI_Inference, LAYER_STRING, LCM_WIDTH, 25-FONT_HEIGHT_REAL, GPL_ALIGN_RIGHT );
+    GPL_WidgetText( &UI_Inference, OutStr );
+}
+
+// ****************************************************************************
+//  Render task
+// ****************************************************************************
+void APP_OLED_Render( void )
+{
+    // New buckets of the shown level since last Frame
+    if( ECG_Wave[ECG_WaveSweep].New )
+    {
+        _APP_OLED_ECG_WaveDraw();
+    }
+
+    GPL_ScreenUpdate();
+}
+
+void APP_OLED_GetFrameStats( APP_OLED_FRAME_STATS *pStats )
+{
+    *pStats = app_oledData.Stats;
+}
+
+static void _APP_OLED_FrameTask( void )
+{
+    uint32_t Now = TC4_GetTickCount();
+    uint32_t Late, Cycles, Us;
+
+    if( (int32_t)(Now-app_oledData.FrameDue) < 0 ) return;
+
+    // Frames passed while late are skipped, next Frame stays on the rate grid
+    Late = (Now-app_oledData.FrameDue)/OLED_FRAME_TICKS;
+    app_oledData.Stats.Skipped += Late;
+    app_oledData.FrameDue += (Late+1)*OLED_FRAME_TICKS;
+
+    // Render time in CPU cycles, a 0.1ms tick is too coarse for a Frame
+    Cycles = CPU_GetCycles();
+    APP_PROBE_Begin( APP_PROBE_RENDER );
+    APP_OLED_Render();
+    APP_PROBE_End( APP_PROBE_RENDER );
+    Us = (CPU_GetCycles()-Cycles)/OLED_CYCLES_PER_US;
+
+    app_oledData.Stats.Rendered++;
+    app_oledData.StatsFrames++;
+    app_oledData.StatsRenderUs += Us;
+    if( Us > 0xFFFF ) Us = 0xFFFF;
+    if( Us > app_oledData.Stats.RenderMax ) app_oledData.Stats.RenderMax = Us;
+
+    // Achieved rate over statistics period
+    if( Now-app_oledData.StatsStart >= OLED_STATS_TICKS )
+    {
+        app_oledData.Stats.Fps10     = (app_oledData.StatsFrames*100000)/(Now-app_oledData.StatsStart);
+        app_oledData.Stats.RenderAvg = app_oledData.StatsRenderUs/app_oledData.StatsFrames;
+#if OLED_STATS_PRINT_ENABLE
+        myprintf("\033[7;1HFPS=%02u.%u Render=%05uus Max=%05uus Skip=%lu",
+                 app_oledData.Stats.Fps10/10, app_oledData.Stats.Fps10%10,
+                 app_oledData.Stats.RenderAvg, app_oledData.Stats.RenderMax, app_oledData.Stats.Skipped);
+#endif
+        app_oledData.StatsStart  = Now;
+        app_oledData.StatsFrames = 0;
+        app_oledData.StatsRenderUs = 0;
+    }
 }
 
 // *****************************************************************************
@@ -230,6 +435,7 @@ void APP_OLED_ML_Inference( char *OutStr )
 void APP_OLED_Initialize ( void )
 {
     app_oledData.state = APP_OLED_STATE_INIT;
+    app_oledData.Pressed = false;
 }
 
 APP_OLED_STATES APP_OLED_Get_State ( void )
@@ -297,7 +503,9 @@ void APP_OLED_Tasks ( void )
                 GPL_ScreenClean();
                 GPL_ScreenUpdate();
 
-                TC4_DelayMS( GRPAHIC_UPDATE_DELAY, DELAY_TIMER_GRPAHIC_UPDATE );
+                // Start render task
+                app_oledData.FrameDue   = TC4_GetTickCount()+OLED_FRAME_TICKS;
+                app_oledData.StatsStart = TC4_GetTickCount();
 
                 // Show all layer
                 GPL_LayerShow( LAYER_GRAPHIC, GPL_SHOW );
@@ -310,19 +518,30 @@ void APP_OLED_Tasks ( void )
 
         case APP_OLED_STATE_UPDATE:
         {
+            // Press and release on separate passes, the Frames go on while BT2 is held
             if( !BT2_Get() )
             {
-                while(!BT2_Get());
-                UI_Language = !UI_Language;
+                if( !app_oledData.Pressed )
+                {
+                    app_oledData.Pressed    = true;
+                    app_oledData.PressStart = TC4_GetTickCount();
+                }
             }
-
-            if( TC4_DelayIsComplete( DELAY_TIMER_GRPAHIC_UPDATE ) )
+            else if( app_oledData.Pressed )
             {
-                GPL_ScreenUpdate();
+                uint32_t Held = TC4_GetTickCount()-app_oledData.PressStart;
 
-                TC4_DelayMS( GRPAHIC_UPDATE_DELAY, DELAY_TIMER_GRPAHIC_UPDATE );
+                app_oledData.Pressed = false;
+
+                // Long press for next Wave sweep, short press for Language
+                if( Held >= OLED_LONG_PRESS_TICKS )
+                    APP_OLED_ECG_WaveSweep( (ECG_WaveSweep+1)%APP_OLED_SWEEP_MAX );
+                else if( Held >= OLED_DEBOUNCE_TICKS )
+                    UI_Language = !UI_Language;
             }
 
+            _APP_OLED_FrameTask();
+
             break;
         }
 
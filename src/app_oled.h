@@ -70,6 +70,44 @@ typedef enum
 
 } APP_OLED_STATES;
 
+// *****************************************************************************
+/* Render statistics
+
+  Summary:
+    Achieved Frame rate and render time of the render task
+
+  Description:
+    Fps10 and RenderAvg are measured over the last statistics period.
+*/
+
+typedef struct
+{
+    uint16_t Fps10;       // Achieved Frames per second x10
+    uint16_t RenderAvg;   // Average render time per Frame (us)
+    uint16_t RenderMax;   // Longest render time per Frame (us)
+    uint32_t Rendered;    // Frames rendered
+    uint32_t Skipped;     // Frames skipped because render was late
+} APP_OLED_FRAME_STATS;
+
+// *****************************************************************************
+/* Wave sweep
+
+  Summary:
+    Time across the Screen of the ECG Wave
+
+  Description:
+    Each sweep is a level of the min/max pyramid, Column spans at 512Hz samples.
+*/
+
+typedef enum
+{
+    APP_OLED_SWEEP_2S = 0,  // 1x,    8 samples per Column
+    APP_OLED_SWEEP_8S,      // 4x,   32 samples per Column
+    APP_OLED_SWEEP_32S,     // 16x, 128 samples per Column
+    APP_OLED_SWEEP_128S,    // 64x, 512 samples per Column, long trend
+    APP_OLED_SWEEP_MAX
+} APP_OLED_SWEEP;
+
 
 // *****************************************************************************
 /* Application Data
@@ -89,6 +127,17 @@ typedef struct
     /* The application's current state */
     APP_OLED_STATES state;
 
+    /* Render task, TC4 tick of next Frame and statistics period, render time in us */
+    uint32_t FrameDue;
+    uint32_t StatsStart;
+    uint32_t StatsFrames;
+    uint32_t StatsRenderUs;
+    APP_OLED_FRAME_STATS Stats;
+
+    /* BT2 held down, TC4 tick it went down */
+    bool     Pressed;
+    uint32_t PressStart;
+
 } APP_OLED_DATA;
 
 // *****************************************************************************
@@ -175,7 +224,10 @@ void APP_OLED_Tasks( void );
 void APP_OLED_ECG_Detect( uint8_t SignalQaulity );
 void APP_OLED_ECG_HeartRate( int16_t nHR );
 void APP_OLED_ECG_FilterType( uint8_t FilterType );
-void APP_OLED_ECG_Wave( int16_t ECG_min, int16_t ECG_max, int16_t ECG_data );
+void APP_OLED_ECG_WaveSample( int16_t ECG_data );
+void APP_OLED_ECG_WaveSweep( APP_OLED_SWEEP sweep );
+void APP_OLED_Render( void );
+void APP_OLED_GetFrameStats( APP_OLED_FRAME_STATS *pStats );
 void APP_OLED_ML_Inference( char *OutStr );
 
 #endif /* _APP_OLED_H */
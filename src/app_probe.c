@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    app_probe.c
+
+  @Summary
+    Latency probes of the ECG, display and ML stages.
+
+  @Description
+    Log2 histograms of the stage latencies, printed by the 't' console key.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <string.h>
+#include "main.h"
+#include "app_probe.h"
+
+#if APP_PROBE_ENABLE
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: File Scope or Global Data                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#define APP_PROBE_CYCLES_PER_US (SYSTICK_FREQ/1000000U)
+
+APP_PROBE_HIST APP_PROBE_Hist[APP_PROBE_STAGES];
+
+static const char *const APP_PROBE_Name[APP_PROBE_STAGES] =
+{
+    "UART gap", "Parse", "Filter", "Detect", "Render", "SPI", "Inference"
+};
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+// Cycles to 0.1us
+static uint32_t _APP_PROBE_Tenths( uint32_t Cycles )
+{
+    return (Cycles/APP_PROBE_CYCLES_PER_US)*10 + ((Cycles%APP_PROBE_CYCLES_PER_US)*10)/APP_PROBE_CYCLES_PER_US;
+}
+
+// Upper edge of bucket k, the longest latency if that is shorter
+static uint32_t _APP_PROBE_Edge( const APP_PROBE_HIST *pHist, uint8_t k )
+{
+    if( k==APP_PROBE_BUCKETS-1 ) return pHist->Max;
+    return ( (1UL<<(k+APP_PROBE_MIN_LOG2)) < pHist->Max ) ? (1UL<<(k+APP_PROBE_MIN_LOG2)) : pHist->Max;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+void APP_PROBE_Record( APP_PROBE_STAGE Stage, uint32_t Cycles )
+{
+    APP_PROBE_HIST *pHist = &APP_PROBE_Hist[Stage];
+    uint32_t Value = Cycles>>(APP_PROBE_MIN_LOG2-1);
+    uint32_t Bucket = 0;
+
+    // floor(log2) by halving, the M0+ has no CLZ
+    if( Value >= 1UL<<16 ) { Value >>= 16; Bucket += 16; }
+    if( Value >= 1UL<<8  ) { Value >>= 8;  Bucket += 8;  }
+    if( Value >= 1UL<<4  ) { Value >>= 4;  Bucket += 4;  }
+    if( Value >= 1UL<<2  ) { Value >>= 2;  Bucket += 2;  }
+    if( Value >= 1UL<<1  ) { Bucket += 1; }
+    if( Bucket >= APP_PROBE_BUCKETS ) Bucket = APP_PROBE_BUCKETS-1;
+
+    pHist->Count[Bucket]++;
+    if( Cycles > pHist->Max ) pHist->Max = Cycles;
+}
+
+void APP_PROBE_Print( void )
+{
+    static const uint8_t Percent[] = { 50, 90, 99 };
+    APP_PROBE_HIST Hist;
+    uint32_t Total, Sum, Edge;
+    uint8_t i, k, p;
+    bool Status;
+
+    myprintf("\r\nLatency us since last 't', percentiles at the upper edge of their log2 bucket\r\n");
+    myprintf("  %-10s %8s %9s %9s %9s %9s\r\n", "Stage", "Count", "p50", "p90", "p99", "Max");
+    for( i=0 ; i<APP_PROBE_STAGES ; i++ )
+    {
+        // Copy and clear at once, SPI is counted in the DMAC interrupt
+        Status = NVIC_INT_Disable();
+        Hist = APP_PROBE_Hist[i];
+        APP_PROBE_Hist[i].Max = 0;
+        memset( APP_PROBE_Hist[i].Count, 0, sizeof(APP_PROBE_Hist[i].Count) );
+        NVIC_INT_Restore( Status );
+
+        Total = 0;
+        for( k=0 ; k<APP_PROBE_BUCKETS ; k++ ) Total += Hist.Count[k];
+        myprintf("  %-10s %8lu", APP_PROBE_Name[i], Total);
+        if( Total==0 )
+        {
+            myprintf("\r\n");
+            continue;
+        }
+
+        for( p=0 ; p<sizeof(Percent) ; p++ )
+        {
+            // Bucket holding the sample at Percent of the count
+            Sum = 0;
+            for( k=0 ; k<APP_PROBE_BUCKETS-1 ; k++ )
+            {
+                Sum += Hist.Count[k];
+                if( (uint64_t)Sum*100 >= (uint64_t)Total*Percent[p] ) break;
+            }
+            Edge = _APP_PROBE_Tenths( _APP_PROBE_Edge( &Hist, k ) );
+            myprintf(" %7lu.%lu", Edge/10, Edge%10);
+        }
+        Edge = _APP_PROBE_Tenths( Hist.Max );
+        myprintf(" %7lu.%lu\r\n   ", Edge/10, Edge%10);
+
+        // Count of each bucket below its upper edge, the last one from its lower edge up
+        for( k=0 ; k<APP_PROBE_BUCKETS ; k++ )
+        {
+            if( Hist.Count[k]==0 ) continue;
+            Edge = _APP_PROBE_Tenths( 1UL<<(k+APP_PROBE_MIN_LOG2-(k==APP_PROBE_BUCKETS-1)) );
+            myprintf(" %s%lu.%lu:%lu", k==APP_PROBE_BUCKETS-1 ? ">=" : "<", Edge/10, Edge%10, Hist.Count[k]);
+        }
+        myprintf("\r\n");
+    }
+}
+#endif
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,134 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    app_probe.h
+
+  @Summary
+    Latency probes of the ECG, display and ML stages.
+
+  @Description
+    A probe takes a timestamp at a stage boundary from the SysTick cycle
+    counter and counts the stage latency in a log2 histogram. The histograms
+    stay in RAM until APP_PROBE_Print() dumps them.
+ */
+/* ************************************************************************** */
+
+#ifndef _APP_PROBE_H    /* Guard against multiple inclusion */
+#define _APP_PROBE_H
+
+#include "definitions.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /* ************************************************************************** */
+    /* ************************************************************************** */
+    /* Section: Constants                                                         */
+    /* ************************************************************************** */
+    /* ************************************************************************** */
+#ifndef APP_PROBE_ENABLE
+#define APP_PROBE_ENABLE   1  // Stage latency histograms, 't' console key prints them
+#endif
+#define APP_PROBE_BUCKETS  20 // Histogram buckets, one per power of 2 cycles
+#define APP_PROBE_MIN_LOG2 6  // Bucket 0 is below 2^6 cycles (1.3us), the last from 2^24 (0.35s) up
+#define APP_PROBE_TICK_CYCLES (SYSTICK_FREQ/1000U) // Cycles per SysTick ms
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Data Types
+    // *****************************************************************************
+    // *****************************************************************************
+typedef enum
+{
+    APP_PROBE_UART = 0, // Between BMD101 reads that returned bytes, longest wait of a byte in the ring buffer
+    APP_PROBE_PARSE,    // BMD101 packet payload, with the stages it calls
+    APP_PROBE_FILTER,   // Filter of one sample
+    APP_PROBE_DETECT,   // Heart beat detection
+    APP_PROBE_RENDER,   // OLED frame render, up to the start of its transfer
+    APP_PROBE_SPI,      // OLED frame transfer, start to the end of the last byte
+    APP_PROBE_INFER,    // Inference pass, a sample or the stages of a deferred pass
+    APP_PROBE_STAGES
+} APP_PROBE_STAGE;
+
+typedef struct
+{
+    uint32_t Start;                     // Cycles at Begin, or at the last Mark
+    uint32_t Max;                       // Longest latency, cycles
+    bool     Marked;                    // Start holds a Mark
+    uint32_t Count[APP_PROBE_BUCKETS];  // [k]: below 2^(k+APP_PROBE_MIN_LOG2) cycles, from half of that
+} APP_PROBE_HIST;
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Interface Functions
+    // *****************************************************************************
+    // *****************************************************************************
+#if APP_PROBE_ENABLE
+extern APP_PROBE_HIST APP_PROBE_Hist[APP_PROBE_STAGES];
+
+// Count one latency of Stage, safe in an interrupt for a stage only probed there
+void APP_PROBE_Record( APP_PROBE_STAGE Stage, uint32_t Cycles );
+
+// Print the histograms and clear them
+void APP_PROBE_Print( void );
+
+// SysTick cycle counter, also right in an interrupt that holds off SysTick_Handler
+static inline uint32_t APP_PROBE_Now( void )
+{
+    uint32_t Tick, Count, Pend;
+
+    do {
+        Tick  = SYSTICK_GetTickCounter();
+        Count = SysTick->VAL;
+        Pend  = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+    } while( Tick != SYSTICK_GetTickCounter() );
+
+    // Counter reloaded, its tick not counted yet
+    if( Pend && Count > APP_PROBE_TICK_CYCLES/2 ) Tick++;
+
+    return Tick*APP_PROBE_TICK_CYCLES + (APP_PROBE_TICK_CYCLES-1-Count);
+}
+
+static inline void APP_PROBE_Begin( APP_PROBE_STAGE Stage )
+{
+    APP_PROBE_Hist[Stage].Start = APP_PROBE_Now();
+}
+
+static inline void APP_PROBE_End( APP_PROBE_STAGE Stage )
+{
+    APP_PROBE_Record( Stage, APP_PROBE_Now()-APP_PROBE_Hist[Stage].Start );
+}
+
+// Latency since the last Mark of Stage
+static inline void APP_PROBE_Mark( APP_PROBE_STAGE Stage )
+{
+    uint32_t Now = APP_PROBE_Now();
+
+    if( APP_PROBE_Hist[Stage].Marked ) APP_PROBE_Record( Stage, Now-APP_PROBE_Hist[Stage].Start );
+    APP_PROBE_Hist[Stage].Start = Now;
+    APP_PROBE_Hist[Stage].Marked = true;
+}
+#else
+#define APP_PROBE_Record( Stage, Cycles )
+#define APP_PROBE_Print()
+#define APP_PROBE_Begin( Stage )
+#define APP_PROBE_End( Stage )
+#define APP_PROBE_Mark( Stage )
+#endif
+
+    /* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _APP_PROBE_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    app_telemetry.c
+
+  @Summary
+    Binary records on the console UART.
+
+  @Description
+    Frames records into the console stream for the host decoder.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include "app_telemetry.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+static void _APP_TELEMETRY_Write( const void *pData, uint8_t Size )
+{
+    if( Size==0 ) return;
+    SERCOM5_USART_Write( (void *)pData, Size );
+    while( SERCOM5_USART_WriteIsBusy() ) {}
+}
+
+static uint8_t _APP_TELEMETRY_Sum( const uint8_t *pData, uint8_t Size )
+{
+    uint8_t Sum = 0;
+
+    while( Size-- ) Sum += *pData++;
+    return Sum;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+void APP_TELEMETRY_Send( const void *pRecord, uint8_t Size, const uint8_t *pTail, uint8_t TailSize )
+{
+    uint8_t Head[2] = { APP_TELEMETRY_START, (uint8_t)(Size+TailSize) };
+    uint8_t Trail[2];
+
+    Trail[0] = ~(uint8_t)( _APP_TELEMETRY_Sum( pRecord, Size )+_APP_TELEMETRY_Sum( pTail, TailSize ) );
+    Trail[1] = APP_TELEMETRY_END;
+
+    // Written in place, the UART is done with each part before the next
+    _APP_TELEMETRY_Write( Head, sizeof(Head) );
+    _APP_TELEMETRY_Write( pRecord, Size );
+    _APP_TELEMETRY_Write( pTail, TailSize );
+    _APP_TELEMETRY_Write( Trail, sizeof(Trail) );
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    app_telemetry.h
+
+  @Summary
+    Binary records on the console UART.
+
+  @Description
+    A record is sent as a frame between the console text: start byte, payload
+    length, payload, checksum and end byte. The host decodes the frames and
+    formats them as text (tools/telemetry), so the target formats none.
+ */
+/* ************************************************************************** */
+
+#ifndef _APP_TELEMETRY_H    /* Guard against multiple inclusion */
+#define _APP_TELEMETRY_H
+
+#include "definitions.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /* ************************************************************************** */
+    /* ************************************************************************** */
+    /* Section: Constants                                                         */
+    /* ************************************************************************** */
+    /* ************************************************************************** */
+#define APP_TELEMETRY_ENABLE   1    // Result record of each window instead of result text
+#define APP_TELEMETRY_FEATURES 0    // 1: result record carries the scaled feature vector of the window
+#define APP_TELEMETRY_START    0x03 // Frame start, as the Data Visualizer frames of app_ecg.c
+#define APP_TELEMETRY_END      0xFC // Frame end
+#define APP_TELEMETRY_RESULT   0x01 // Record type of APP_TELEMETRY_RESULT_RECORD
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Data Types
+    // *****************************************************************************
+    // *****************************************************************************
+// Result of one classified window, little endian. A feature vector of Features
+// bytes follows it in the same frame.
+typedef struct __attribute__((packed))
+{
+    uint8_t  Type;       // APP_TELEMETRY_RESULT
+    uint8_t  Source;     // Classifier, SML_SOURCE_* of sml_recognition_run.h
+    int8_t   Class;      // Class of the window, 0 unknown
+    int8_t   Shown;      // Class on the OLED after the vote, -1 without SML_VOTE_ENABLE
+    uint32_t Tick;       // TC4 tick count of the result, 0.1ms
+    uint32_t Window;     // Window number since 'k', from 1
+    uint16_t Duty10;     // Inference share of the hop, 0.1%
+    uint16_t Influence;  // Influence field of the PME pattern, 0 for the rhythm screen
+    uint16_t Distance;   // PME distance, irregularity per mille for the rhythm screen
+    uint8_t  Pattern;    // PME pattern that fired
+    uint8_t  Features;   // Feature vector bytes after the record
+} APP_TELEMETRY_RESULT_RECORD;
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Interface Functions
+    // *****************************************************************************
+    // *****************************************************************************
+// Frame of pRecord followed by pTail, sent before returning. The payload is at
+// most 255 bytes, the checksum is the inverted byte sum as in BMD101 packets.
+void APP_TELEMETRY_Send( const void *pRecord, uint8_t Size, const uint8_t *pTail, uint8_t TailSize );
+
+    /* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _APP_TELEMETRY_H */
+
+/* *****************************************************************************
+ End of File
+ */
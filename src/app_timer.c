@@ -0,0 +1,220 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    app_timer.c
+
+  @Summary
+    Tickless timer queue on TC4.
+
+  @Description
+    Delta queue of the pending timers, the TC4 compare set for the first one.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include "app_timer.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: File Scope or Global Data                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#define APP_TIMER_WRAP_COUNTS 0x10000UL // TC4 counts between overflows
+#define APP_TIMER_WRAP_TICKS  (APP_TIMER_WRAP_COUNTS/APP_TIMER_COUNTS_PER_TICK) // Whole ticks of a wrap
+#define APP_TIMER_WRAP_REM    (APP_TIMER_WRAP_COUNTS%APP_TIMER_COUNTS_PER_TICK) // Counts left over
+#define APP_TIMER_LEAD        4 // Counts a compare is set ahead of the counter, it expires at once when closer
+
+static volatile uint32_t APP_TIMER_Wraps = 0;     // TC4 overflows, upper half of the count
+static volatile uint32_t APP_TIMER_TickBase = 0;  // Ticks at the last overflow
+static volatile uint32_t APP_TIMER_TickRem = 0;   // Counts past APP_TIMER_TickBase at the last overflow
+static APP_TIMER *APP_TIMER_Queue = NULL;         // Pending timers by deadline
+static uint32_t   APP_TIMER_QueueTime;            // Count the Delta of the first timer is from
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+// Count extended by the overflows, with interrupts off or in the TC4 interrupt
+static uint32_t _APP_TIMER_Now( uint32_t *pTicks )
+{
+    uint32_t Count = TC4_Timer16bitCounterGet();
+    uint32_t Wraps = APP_TIMER_Wraps;
+    uint32_t Rem = APP_TIMER_TickRem;
+
+    // Overflowed, its interrupt not run yet
+    if( (TC4_REGS->COUNT16.TC_INTFLAG & TC_INTFLAG_OVF_Msk) && Count < APP_TIMER_WRAP_COUNTS/2 )
+    {
+        Wraps++;
+        Rem += APP_TIMER_WRAP_COUNTS;
+    }
+    if( pTicks ) *pTicks = APP_TIMER_TickBase + (Rem+Count)/APP_TIMER_COUNTS_PER_TICK;
+
+    return (Wraps<<16) | Count;
+}
+
+// Compare of the first timer, false when it is due or too close to set
+static bool _APP_TIMER_Program( void )
+{
+    APP_TIMER *pTimer = APP_TIMER_Queue;
+    uint32_t Due;
+
+    TC4_REGS->COUNT16.TC_INTENCLR = TC_INTENCLR_MC1_Msk;
+    if( pTimer==NULL ) return true;
+
+    Due = APP_TIMER_QueueTime+pTimer->Delta;
+    if( (int32_t)(Due-_APP_TIMER_Now( NULL )) <= APP_TIMER_LEAD ) return false;
+    // Beyond this wrap, set again by an overflow before it
+    if( Due-_APP_TIMER_Now( NULL ) >= APP_TIMER_WRAP_COUNTS ) return true;
+
+    TC4_Timer16bitCompareSet( (uint16_t)Due );
+    TC4_REGS->COUNT16.TC_INTFLAG = TC_INTFLAG_MC1_Msk;
+    TC4_REGS->COUNT16.TC_INTENSET = TC_INTENSET_MC1_Msk;
+
+    // Passed while the compare was set, the match may be missed
+    return (int32_t)(Due-_APP_TIMER_Now( NULL )) > 0;
+}
+
+// Compare of a new first timer, the interrupt expires it when it is due already
+static void _APP_TIMER_Reprogram( void )
+{
+    if( !_APP_TIMER_Program() ) NVIC_SetPendingIRQ( TC4_IRQn );
+}
+
+static void _APP_TIMER_Remove( APP_TIMER *pTimer )
+{
+    APP_TIMER **ppNext;
+
+    if( !pTimer->Queued ) return;
+    for( ppNext=&APP_TIMER_Queue ; *ppNext!=pTimer ; ppNext=&(*ppNext)->pNext ) {}
+    *ppNext = pTimer->pNext;
+    if( pTimer->pNext ) pTimer->pNext->Delta += pTimer->Delta;
+    pTimer->Queued = false;
+}
+
+// TC4 interrupt: overflow, compare match or a due timer queued with interrupts off
+static void _APP_TIMER_Handler( TC_TIMER_STATUS Status, uintptr_t Context )
+{
+    APP_TIMER *pTimer;
+    uint32_t Now;
+
+    if( Status & TC_INTFLAG_OVF_Msk )
+    {
+        APP_TIMER_Wraps++;
+        APP_TIMER_TickRem += APP_TIMER_WRAP_REM;
+        APP_TIMER_TickBase += APP_TIMER_WRAP_TICKS + APP_TIMER_TickRem/APP_TIMER_COUNTS_PER_TICK;
+        APP_TIMER_TickRem %= APP_TIMER_COUNTS_PER_TICK;
+    }
+
+    do {
+        Now = _APP_TIMER_Now( NULL );
+        while( (pTimer = APP_TIMER_Queue)!=NULL && (int32_t)(Now-APP_TIMER_QueueTime-pTimer->Delta) >= 0 )
+        {
+            APP_TIMER_QueueTime += pTimer->Delta;
+            APP_TIMER_Queue = pTimer->pNext;
+            pTimer->Queued = false;
+            pTimer->Expired = true;
+            if( pTimer->Callback ) pTimer->Callback( pTimer->Context );
+        }
+    } while( !_APP_TIMER_Program() );
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+void APP_TIMER_Initialize( void )
+{
+    TC4_TimerCallbackRegister( _APP_TIMER_Handler, (uintptr_t)NULL );
+    TC4_TimerStart();
+}
+
+uint32_t APP_TIMER_GetTicks( void )
+{
+    uint32_t Ticks;
+    bool Status = NVIC_INT_Disable();
+
+    _APP_TIMER_Now( &Ticks );
+    NVIC_INT_Restore( Status );
+
+    return Ticks;
+}
+
+uint32_t APP_TIMER_GetCounts( void )
+{
+    uint32_t Count;
+    bool Status = NVIC_INT_Disable();
+
+    Count = _APP_TIMER_Now( NULL );
+    NVIC_INT_Restore( Status );
+
+    return Count;
+}
+
+void APP_TIMER_Callback( APP_TIMER *pTimer, APP_TIMER_CALLBACK Callback, uintptr_t Context )
+{
+    pTimer->Callback = Callback;
+    pTimer->Context = Context;
+}
+
+void APP_TIMER_Start( APP_TIMER *pTimer, uint32_t Ticks )
+{
+    APP_TIMER **ppNext;
+    uint32_t Now, Delta;
+    bool Status = NVIC_INT_Disable();
+
+    _APP_TIMER_Remove( pTimer );
+    pTimer->Expired = false;
+
+    Now = _APP_TIMER_Now( NULL );
+    if( APP_TIMER_Queue==NULL ) APP_TIMER_QueueTime = Now;
+    if( Ticks > APP_TIMER_MAX_TICKS ) Ticks = APP_TIMER_MAX_TICKS;
+    Delta = Now-APP_TIMER_QueueTime + Ticks*APP_TIMER_COUNTS_PER_TICK;
+
+    // Behind the timers due before or with it, a tie expires in start order
+    for( ppNext=&APP_TIMER_Queue ; *ppNext!=NULL && (*ppNext)->Delta<=Delta ; ppNext=&(*ppNext)->pNext )
+    {
+        Delta -= (*ppNext)->Delta;
+    }
+    pTimer->Delta = Delta;
+    pTimer->pNext = *ppNext;
+    if( pTimer->pNext ) pTimer->pNext->Delta -= Delta;
+    *ppNext = pTimer;
+    pTimer->Queued = true;
+
+    if( APP_TIMER_Queue==pTimer ) _APP_TIMER_Reprogram();
+    NVIC_INT_Restore( Status );
+}
+
+void APP_TIMER_Stop( APP_TIMER *pTimer )
+{
+    bool Status = NVIC_INT_Disable();
+    bool First = ( APP_TIMER_Queue==pTimer );
+
+    _APP_TIMER_Remove( pTimer );
+    pTimer->Expired = false;
+    if( First ) _APP_TIMER_Reprogram();
+    NVIC_INT_Restore( Status );
+}
+
+bool APP_TIMER_Expired( APP_TIMER *pTimer )
+{
+    // Only set in the interrupt of a pending timer, polled each main loop pass
+    if( !pTimer->Expired ) return false;
+    pTimer->Expired = false;
+
+    return true;
+}
+
+/* *****************************************************************************
+ End of File
+ */
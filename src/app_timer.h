@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    app_timer.h
+
+  @Summary
+    Tickless timer queue on TC4.
+
+  @Description
+    TC4 counts freely at 750kHz. Its overflow extends the count and keeps the
+    0.1ms tick count, its compare is set for the earliest pending timer only.
+    Pending timers are kept in a delta queue sorted by deadline, so an
+    interrupt only comes at a deadline or at the 87ms overflow.
+ */
+/* ************************************************************************** */
+
+#ifndef _APP_TIMER_H    /* Guard against multiple inclusion */
+#define _APP_TIMER_H
+
+#include "definitions.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /* ************************************************************************** */
+    /* ************************************************************************** */
+    /* Section: Constants                                                         */
+    /* ************************************************************************** */
+    /* ************************************************************************** */
+#define APP_TIMER_COUNTS_PER_TICK 75          // TC4 counts per 0.1ms tick, 48MHz/64
+#define APP_TIMER_TICKS_PER_MS    10
+#define APP_TIMER_MAX_TICKS       (0x7FFFFFFFUL/APP_TIMER_COUNTS_PER_TICK) // Longest delay, 47 minutes
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Data Types
+    // *****************************************************************************
+    // *****************************************************************************
+// Called in the TC4 interrupt at expiry, it may start its timer again
+typedef void (*APP_TIMER_CALLBACK)( uintptr_t Context );
+
+typedef struct APP_TIMER
+{
+    struct APP_TIMER  *pNext;    // Next pending timer
+    uint32_t           Delta;    // Counts after the timer before it, or after the queue time for the first
+    APP_TIMER_CALLBACK Callback; // NULL to poll APP_TIMER_Expired() only
+    uintptr_t          Context;
+    volatile bool      Queued;   // Pending
+    volatile bool      Expired;  // Expired since the last start, cleared by APP_TIMER_Expired()
+} APP_TIMER;
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Interface Functions
+    // *****************************************************************************
+    // *****************************************************************************
+// Take over TC4 and start it, before any other call
+void APP_TIMER_Initialize( void );
+
+// Monotonic 0.1ms tick count, wraps after 4.9 days
+uint32_t APP_TIMER_GetTicks( void );
+
+// Monotonic TC4 count, 1.33us, wraps after 95 minutes
+uint32_t APP_TIMER_GetCounts( void );
+
+// Callback of pTimer, NULL for a flag only, set while it is not pending
+void APP_TIMER_Callback( APP_TIMER *pTimer, APP_TIMER_CALLBACK Callback, uintptr_t Context );
+
+// (Re)start pTimer to expire Ticks from now, up to APP_TIMER_MAX_TICKS
+void APP_TIMER_Start( APP_TIMER *pTimer, uint32_t Ticks );
+
+// Take pTimer off the queue, it does not expire
+void APP_TIMER_Stop( APP_TIMER *pTimer );
+
+// True once after pTimer expired
+bool APP_TIMER_Expired( APP_TIMER *pTimer );
+
+    /* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _APP_TIMER_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -151,6 +151,8 @@ void SYS_Initialize ( void* data )
     SERCOM5_USART_Initialize();
 
     SERCOM4_SPI_Initialize();
+    DMAC_Initialize();
+
 
     ADC_Initialize();
     TC3_TimerInitialize();
@@ -61,6 +61,7 @@ void Reset_Handler (void);
 void NonMaskableInt_Handler (void);
 void HardFault_Handler (void);
 void SysTick_Handler (void);
+void DMAC_InterruptHandler (void);
 void SERCOM2_USART_InterruptHandler (void);
 void SERCOM3_I2C_InterruptHandler (void);
 void SERCOM5_USART_InterruptHandler (void);
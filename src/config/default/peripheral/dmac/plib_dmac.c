@@ -0,0 +1,265 @@
+/*******************************************************************************
+  Direct Memory Access Controller (DMAC) PLIB
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_dmac.c
+
+  Summary
+    Source for DMAC peripheral library interface Implementation.
+
+  Description
+    This file defines the interface to the DMAC peripheral library. This
+    library provides access to and control of the DMAC controller.
+
+  Remarks:
+    None.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#include "interrupts.h"
+#include "plib_dmac.h"
+#include "peripheral/nvic/plib_nvic.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Descriptor and write-back sections must be 128-bit aligned */
+static dmac_descriptor_registers_t descriptor_section[DMAC_CHANNELS_NUMBER] __ALIGNED(16);
+static dmac_descriptor_registers_t write_back_section[DMAC_CHANNELS_NUMBER] __ALIGNED(16);
+
+volatile static DMAC_CH_OBJECT dmacChannelObj[DMAC_CHANNELS_NUMBER];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: DMAC PLib Interface Implementations
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+This function initializes the DMAC controller of the device.
+********************************************************************************/
+
+void DMAC_Initialize( void )
+{
+    uint8_t channel;
+
+    /* Enable the DMAC clocks */
+    PM_REGS->PM_AHBMASK |= PM_AHBMASK_DMAC_Msk;
+    PM_REGS->PM_APBBMASK |= PM_APBBMASK_DMAC_Msk;
+
+    /* Initialize DMAC Channel objects */
+    for(channel = 0U; channel < DMAC_CHANNELS_NUMBER; channel++)
+    {
+        dmacChannelObj[channel].inUse = 0U;
+        dmacChannelObj[channel].callback = NULL;
+        dmacChannelObj[channel].context = 0U;
+        dmacChannelObj[channel].busyStatus = false;
+    }
+
+    /* Update the Base address and Write Back address register */
+    DMAC_REGS->DMAC_BASEADDR = (uint32_t)descriptor_section;
+    DMAC_REGS->DMAC_WRBADDR  = (uint32_t)write_back_section;
+
+    /* Update the Priority Control register */
+    DMAC_REGS->DMAC_PRICTRL0 = DMAC_PRICTRL0_LVLPRI0(1UL) | DMAC_PRICTRL0_RRLVLEN0_Msk;
+
+    /***************** Configure DMA channel 0 ********************/
+
+    /* SERCOM4 SPI Transmit: one byte per DRE trigger into SERCOM_DATA */
+    DMAC_REGS->DMAC_CHID = 0U;
+
+    DMAC_REGS->DMAC_CHCTRLB = DMAC_CHCTRLB_TRIGACT_BEAT | DMAC_CHCTRLB_TRIGSRC(SERCOM4_DMAC_ID_TX) | DMAC_CHCTRLB_LVL(0UL);
+
+    descriptor_section[0].DMAC_BTCTRL = DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk;
+
+    dmacChannelObj[0].inUse = 1U;
+
+    DMAC_REGS->DMAC_CHINTENSET = DMAC_CHINTENSET_TERR_Msk | DMAC_CHINTENSET_TCMPL_Msk;
+
+    /* Enable the DMAC module & Priority Level x Enable */
+    DMAC_REGS->DMAC_CTRL = DMAC_CTRL_DMAENABLE_Msk | DMAC_CTRL_LVLEN0_Msk;
+}
+
+/*******************************************************************************
+    This function schedules a DMA transfer on the specified DMA channel.
+********************************************************************************/
+
+bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize )
+{
+    uint8_t beatSize;
+    bool returnStatus = false;
+
+    if(dmacChannelObj[channel].busyStatus == false)
+    {
+        /* Set the busy status before the channel can raise an interrupt */
+        dmacChannelObj[channel].busyStatus = true;
+
+        beatSize = (uint8_t)((descriptor_section[channel].DMAC_BTCTRL & DMAC_BTCTRL_BEATSIZE_Msk) >> DMAC_BTCTRL_BEATSIZE_Pos);
+
+        /* Incrementing addresses point to the end of the block */
+        if((descriptor_section[channel].DMAC_BTCTRL & DMAC_BTCTRL_SRCINC_Msk) == DMAC_BTCTRL_SRCINC_Msk)
+        {
+            descriptor_section[channel].DMAC_SRCADDR = (uint32_t)((uintptr_t)srcAddr + blockSize);
+        }
+        else
+        {
+            descriptor_section[channel].DMAC_SRCADDR = (uint32_t)(uintptr_t)srcAddr;
+        }
+
+        if((descriptor_section[channel].DMAC_BTCTRL & DMAC_BTCTRL_DSTINC_Msk) == DMAC_BTCTRL_DSTINC_Msk)
+        {
+            descriptor_section[channel].DMAC_DSTADDR = (uint32_t)((uintptr_t)destAddr + blockSize);
+        }
+        else
+        {
+            descriptor_section[channel].DMAC_DSTADDR = (uint32_t)(uintptr_t)destAddr;
+        }
+
+        /* Single block transfer */
+        descriptor_section[channel].DMAC_DESCADDR = 0U;
+
+        descriptor_section[channel].DMAC_BTCNT = (uint16_t)(blockSize >> beatSize);
+
+        descriptor_section[channel].DMAC_BTCTRL |= DMAC_BTCTRL_VALID_Msk;
+
+        /* Clear stale flags and enable the channel */
+        DMAC_REGS->DMAC_CHID = (uint8_t)channel;
+
+        DMAC_REGS->DMAC_CHINTFLAG = (uint8_t)(DMAC_CHINTFLAG_TERR_Msk | DMAC_CHINTFLAG_TCMPL_Msk | DMAC_CHINTFLAG_SUSP_Msk);
+
+        DMAC_REGS->DMAC_CHCTRLA |= DMAC_CHCTRLA_ENABLE_Msk;
+
+        returnStatus = true;
+    }
+
+    return returnStatus;
+}
+
+/*******************************************************************************
+    This function function allows a DMAC PLIB client to set an event handler.
+********************************************************************************/
+void DMAC_ChannelCallbackRegister( DMAC_CHANNEL channel, const DMAC_CHANNEL_CALLBACK eventHandler, const uintptr_t contextHandle )
+{
+    dmacChannelObj[channel].callback = eventHandler;
+
+    dmacChannelObj[channel].context  = contextHandle;
+}
+
+/*******************************************************************************
+    This function returns the status of the channel.
+********************************************************************************/
+bool DMAC_ChannelIsBusy( DMAC_CHANNEL channel )
+{
+    return dmacChannelObj[channel].busyStatus;
+}
+
+/*******************************************************************************
+    This function disables the specified DMAC channel.
+********************************************************************************/
+void DMAC_ChannelDisable( DMAC_CHANNEL channel )
+{
+    bool interruptState = NVIC_INT_Disable();
+
+    DMAC_REGS->DMAC_CHID = (uint8_t)channel;
+
+    DMAC_REGS->DMAC_CHCTRLA &= (uint8_t)(~DMAC_CHCTRLA_ENABLE_Msk);
+
+    while((DMAC_REGS->DMAC_CHCTRLA & DMAC_CHCTRLA_ENABLE_Msk) != 0U)
+    {
+        /* Wait till the channel is disabled */
+    }
+
+    dmacChannelObj[channel].busyStatus = false;
+
+    NVIC_INT_Restore(interruptState);
+}
+
+/*******************************************************************************
+    This function returns the number of beats already transferred.
+********************************************************************************/
+uint16_t DMAC_ChannelGetTransferredCount( DMAC_CHANNEL channel )
+{
+    return descriptor_section[channel].DMAC_BTCNT - write_back_section[channel].DMAC_BTCNT;
+}
+
+/*******************************************************************************
+    This function handles the DMA interrupt events.
+*/
+void __attribute__((used)) DMAC_InterruptHandler( void )
+{
+    volatile DMAC_CH_OBJECT *dmacChObj;
+    uint8_t channel;
+    uint8_t chanIntFlagStatus;
+    DMAC_TRANSFER_EVENT event = DMAC_TRANSFER_EVENT_NONE;
+
+    /* Get active channel number */
+    channel = (uint8_t)(DMAC_REGS->DMAC_INTPEND & DMAC_INTPEND_ID_Msk);
+
+    dmacChObj = &dmacChannelObj[channel];
+
+    /* Update the DMAC channel ID */
+    DMAC_REGS->DMAC_CHID = channel;
+
+    /* Get the DMAC channel interrupt status */
+    chanIntFlagStatus = DMAC_REGS->DMAC_CHINTFLAG;
+
+    if((chanIntFlagStatus & DMAC_CHINTFLAG_TERR_Msk) != 0U)
+    {
+        /* Clear transfer error flag */
+        DMAC_REGS->DMAC_CHINTFLAG = DMAC_CHINTFLAG_TERR_Msk;
+
+        event = DMAC_TRANSFER_EVENT_ERROR;
+    }
+    else if((chanIntFlagStatus & DMAC_CHINTFLAG_TCMPL_Msk) != 0U)
+    {
+        /* Clear the transfer complete flag */
+        DMAC_REGS->DMAC_CHINTFLAG = DMAC_CHINTFLAG_TCMPL_Msk;
+
+        event = DMAC_TRANSFER_EVENT_COMPLETE;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    /* Release the channel before the callback so it can chain the next block */
+    dmacChObj->busyStatus = false;
+
+    if((dmacChObj->callback != NULL) && (event != DMAC_TRANSFER_EVENT_NONE))
+    {
+        uintptr_t context = dmacChObj->context;
+
+        dmacChObj->callback(event, context);
+    }
+}
@@ -84,10 +84,11 @@ void TC4_TimerInitialize( void )
     }
 
     /* Configure counter mode & prescaler */
-    TC4_REGS->COUNT16.TC_CTRLA = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV256 | TC_CTRLA_WAVEGEN_MPWM ;
+    TC4_REGS->COUNT16.TC_CTRLA = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV64 | TC_CTRLA_WAVEGEN_MPWM ;
 
     /* Configure timer period */
-    TC4_REGS->COUNT16.TC_CC[0U] = 17U;
+    TC4_REGS->COUNT16.TC_CC[0U] = 65535U;
+    TC4_REGS->COUNT16.TC_CC[1U] = 0U;
 
     /* Clear all interrupt flags */
     TC4_REGS->COUNT16.TC_INTFLAG = TC_INTFLAG_Msk;
@@ -125,7 +126,7 @@ void TC4_TimerStop( void )
 
 uint32_t TC4_TimerFrequencyGet( void )
 {
-    return (uint32_t)(187500UL);
+    return (uint32_t)(750000UL);
 }
 
 void TC4_TimerCommandSet(TC_COMMAND command)
@@ -186,6 +187,16 @@ uint16_t TC4_Timer16bitPeriodGet( void )
     return (uint16_t)TC4_REGS->COUNT16.TC_CC[0];
 }
 
+/* Configure timer compare value */
+void TC4_Timer16bitCompareSet( uint16_t compare )
+{
+    TC4_REGS->COUNT16.TC_CC[1] = compare;
+    while((TC4_REGS->COUNT16.TC_STATUS & TC_STATUS_SYNCBUSY_Msk)!= 0U)
+    {
+        /* Wait for Write Synchronization */
+    }
+}
+
 
 
 /* Register callback function */
@@ -201,8 +212,8 @@ void __attribute__((used)) TC4_TimerInterruptHandler( void )
 {
     TC_TIMER_STATUS status;
     status = (TC_TIMER_STATUS) (TC4_REGS->COUNT16.TC_INTFLAG);
-    /* Clear interrupt flags */
-    TC4_REGS->COUNT16.TC_INTFLAG = TC_INTFLAG_Msk;
+    /* Clear the interrupt flags read, a flag set since then stays pending */
+    TC4_REGS->COUNT16.TC_INTFLAG = (uint8_t)status;
     if(TC4_CallbackObject.callback != NULL)
     {
         uintptr_t context = TC4_CallbackObject.context;
@@ -100,6 +100,8 @@ void TC4_Timer16bitPeriodSet( uint16_t period );
 
 uint16_t TC4_Timer16bitPeriodGet( void );
 
+void TC4_Timer16bitCompareSet( uint16_t compare );
+
 uint16_t TC4_Timer16bitCounterGet( void );
 
 void TC4_Timer16bitCounterSet( uint16_t count );
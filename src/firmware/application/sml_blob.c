@@ -0,0 +1,270 @@
+#include "definitions.h"
+#include "sml_blob.h"
+#include "sml_learn.h"
+#include <stddef.h>
+#include <string.h>
+
+//Two slots of SML_BLOB_SLOT_ROWS rows, each a commit page followed by the blob. An upload goes to the
+//slot that is not active: its first row is erased, the blob is written a page at a time and checked in
+//flash, then the commit page is written with the next sequence. The newest commit wins, so a cut upload
+//leaves the active model as it was. A commit without blob (blob_crc 0) selects the built-in model.
+
+#define SML_BLOB_ADDRESS    (FLASH_ADDR+FLASH_SIZE-(SML_STORE_ROWS+2*SML_BLOB_SLOT_ROWS)*NVMCTRL_FLASH_ROWSIZE)
+#define SML_BLOB_SLOT_SIZE  (SML_BLOB_SLOT_ROWS*NVMCTRL_FLASH_ROWSIZE)
+#define SML_BLOB_MAX_SIZE   (SML_BLOB_SLOT_SIZE-NVMCTRL_FLASH_PAGESIZE)
+#define SML_COMMIT_MAGIC    0x54494D43u //"CMIT"
+#define SML_BLOB_CRC_OFFSET offsetof(sml_blob_header_t, size)
+
+typedef struct {
+    uint32_t magic;    //SML_COMMIT_MAGIC
+    uint32_t sequence; //counts commits, the highest one is active
+    uint32_t blob_crc; //crc of the committed blob, 0 for the built-in model
+    uint32_t check;    //CRC-32 of the fields above
+} sml_commit_t;
+
+static const sml_blob_t *sml_blob = NULL;        //active model, NULL built-in
+static const sml_blob_t *sml_blob_in_use = NULL; //blob of the window being classified
+static int32_t sml_blob_slot = -1;               //slot of the newest commit, -1 none
+static uint32_t sml_blob_sequence = 0;
+static uint32_t sml_blob_layout;                 //CRC-32 of the built-in feature layout
+
+//upload state
+static int32_t sml_upload_slot = -1;
+static uint32_t sml_upload_size;
+static uint32_t sml_upload_page[NVMCTRL_FLASH_PAGESIZE / 4];
+
+uint32_t sml_crc32(uint32_t crc, const uint8_t *data, uint32_t size)
+{
+    int32_t k;
+
+    crc = ~crc;
+    while (size--){
+        crc ^= *data++;
+        for (k = 0; k < 8; k++){
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t sml_slot_address(int32_t slot)
+{
+    return SML_BLOB_ADDRESS + slot * SML_BLOB_SLOT_SIZE;
+}
+
+static const sml_commit_t *sml_slot_commit(int32_t slot)
+{
+    const sml_commit_t *commit = (const sml_commit_t *)sml_slot_address(slot);
+
+    if (commit->magic != SML_COMMIT_MAGIC ||
+        commit->check != sml_crc32(0, (const uint8_t *)commit, offsetof(sml_commit_t, check))){
+        return NULL;
+    }
+    return commit;
+}
+
+static const sml_blob_t *sml_slot_blob(int32_t slot)
+{
+    return (const sml_blob_t *)(sml_slot_address(slot) + NVMCTRL_FLASH_PAGESIZE);
+}
+
+static bool sml_blob_valid(const sml_blob_t *blob)
+{
+    const sml_blob_header_t *header = &blob->header;
+    int32_t i;
+
+    if (header->magic != SML_BLOB_MAGIC || header->version != SML_BLOB_VERSION ||
+        header->features != SML_FIXED_FEATURES || header->window != SML_FIXED_WINDOW ||
+        header->layout != sml_blob_layout || header->patterns == 0 ||
+        header->size != sizeof(sml_blob_t) + header->patterns * sizeof(sml_blob_pattern_t) ||
+        header->size > SML_BLOB_MAX_SIZE){
+        return false;
+    }
+    if (header->crc != sml_crc32(0, (const uint8_t *)blob + SML_BLOB_CRC_OFFSET, header->size - SML_BLOB_CRC_OFFSET)){
+        return false;
+    }
+    //sml_fixed_features divides by the maxima, only normal floats
+    for (i = 0; i < SML_FIXED_FEATURES; i++){
+        if ((blob->max_mant[i] >> 23) != 1){
+            return false;
+        }
+    }
+    return true;
+}
+
+//blob a commit selects, NULL for the built-in model or when the blob does not check
+static const sml_blob_t *sml_commit_blob(int32_t slot, const sml_commit_t *commit)
+{
+    const sml_blob_t *blob = sml_slot_blob(slot);
+
+    if (commit->blob_crc == 0 || blob->header.crc != commit->blob_crc || !sml_blob_valid(blob)){
+        return NULL;
+    }
+    return blob;
+}
+
+static void sml_flash_write(const uint32_t *page, uint32_t address)
+{
+    //the CPU stalls on flash reads while the row is erased or the page is written
+    while (NVMCTRL_IsBusy());
+    if (address % NVMCTRL_FLASH_ROWSIZE == 0){
+        NVMCTRL_RowErase(address);
+        while (NVMCTRL_IsBusy());
+    }
+    NVMCTRL_PageWrite((uint32_t *)page, address);
+    while (NVMCTRL_IsBusy());
+}
+
+void sml_blob_init(void)
+{
+    const sml_commit_t *commit, *newest = NULL;
+    uint8_t layout[SML_FIXED_FEATURES + 1];
+    int32_t slot;
+
+    memcpy(layout, sml_fixed_bin, SML_FIXED_FEATURES);
+    layout[SML_FIXED_FEATURES] = SML_FIXED_HARMONICS;
+    sml_blob_layout = sml_crc32(0, layout, sizeof(layout));
+
+    for (slot = 0; slot < 2; slot++){
+        commit = sml_slot_commit(slot);
+        if (commit != NULL && (newest == NULL || (int32_t)(commit->sequence - newest->sequence) > 0)){
+            newest = commit;
+            sml_blob_slot = slot;
+        }
+    }
+    if (newest != NULL){
+        sml_blob_sequence = newest->sequence;
+        sml_blob = sml_commit_blob(sml_blob_slot, newest);
+    }
+}
+
+const sml_blob_t *sml_blob_acquire(void)
+{
+    sml_blob_in_use = sml_blob;
+    return sml_blob;
+}
+
+void sml_blob_release(void)
+{
+    sml_blob_in_use = NULL;
+}
+
+const sml_blob_t *sml_blob_active(void)
+{
+    return sml_blob;
+}
+
+int32_t sml_blob_classify(const sml_blob_t *blob, const uint8_t *feature_vector, sml_blob_result_t *result)
+{
+    const sml_blob_pattern_t *pattern;
+    uint16_t dist, best = 0xFFFF;
+    int32_t p, i;
+
+    result->pattern = 0;
+    for (p = 0; p < blob->header.patterns; p++){
+        pattern = &blob->pattern[p];
+        for (i = 0, dist = 0; i < SML_FIXED_FEATURES; i++){
+            dist += (pattern->vector[i] > feature_vector[i]) ? pattern->vector[i] - feature_vector[i]
+                                                             : feature_vector[i] - pattern->vector[i];
+        }
+        if (dist < best){
+            best = dist;
+            result->pattern = (uint16_t)p;
+        }
+    }
+    pattern = &blob->pattern[result->pattern];
+    result->category = pattern->category;
+    result->influence = pattern->influence;
+    result->distance = best;
+    return pattern->category;
+}
+
+bool sml_blob_begin(void)
+{
+    int32_t slot = (sml_blob_slot + 1) % 2;
+
+    //the window started before the last commit may still read the other slot
+    if (sml_blob_in_use != NULL && sml_blob_in_use == sml_slot_blob(slot)){
+        return false;
+    }
+    sml_upload_slot = slot;
+    sml_upload_size = 0;
+    //drops the old commit of the slot first, it is never the active one
+    while (NVMCTRL_IsBusy());
+    NVMCTRL_RowErase(sml_slot_address(slot));
+    while (NVMCTRL_IsBusy());
+    return true;
+}
+
+bool sml_blob_write(uint8_t data)
+{
+    uint32_t offset = sml_upload_size % NVMCTRL_FLASH_PAGESIZE;
+
+    if (sml_upload_slot < 0 || sml_upload_size >= SML_BLOB_MAX_SIZE){
+        return false;
+    }
+    if (offset == 0){
+        memset(sml_upload_page, 0xFF, sizeof(sml_upload_page));
+    }
+    ((uint8_t *)sml_upload_page)[offset] = data;
+    sml_upload_size++;
+    if (offset == NVMCTRL_FLASH_PAGESIZE - 1){
+        //the first page of the slot is the commit, row 0 is erased already
+        sml_flash_write(sml_upload_page, sml_slot_address(sml_upload_slot) + sml_upload_size);
+    }
+    return true;
+}
+
+int32_t sml_blob_end(void)
+{
+    sml_commit_t commit;
+    const sml_blob_t *blob;
+    uint32_t page[NVMCTRL_FLASH_PAGESIZE / 4];
+    int32_t slot = sml_upload_slot;
+
+    if (slot < 0){
+        return -1;
+    }
+    sml_upload_slot = -1;
+    if (sml_upload_size % NVMCTRL_FLASH_PAGESIZE){
+        sml_flash_write(sml_upload_page, sml_slot_address(slot) + NVMCTRL_FLASH_PAGESIZE +
+                        sml_upload_size - sml_upload_size % NVMCTRL_FLASH_PAGESIZE);
+    }
+    NVMCTRL_CacheInvalidate();
+    if (NVMCTRL_ErrorGet() != NVMCTRL_ERROR_NONE){
+        return -3;
+    }
+
+    blob = sml_slot_blob(slot);
+    commit.magic = SML_COMMIT_MAGIC;
+    commit.sequence = sml_blob_sequence + 1;
+    commit.blob_crc = 0;
+    if (sml_upload_size){
+        if (sml_upload_size != blob->header.size || !sml_blob_valid(blob) || blob->header.crc == 0){
+            return -2;
+        }
+        commit.blob_crc = blob->header.crc;
+    }
+    commit.check = sml_crc32(0, (const uint8_t *)&commit, offsetof(sml_commit_t, check));
+
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page, &commit, sizeof(commit));
+    while (NVMCTRL_IsBusy());
+    NVMCTRL_PageWrite(page, sml_slot_address(slot));
+    while (NVMCTRL_IsBusy());
+    NVMCTRL_CacheInvalidate();
+    if (NVMCTRL_ErrorGet() != NVMCTRL_ERROR_NONE || sml_slot_commit(slot) == NULL){
+        return -3;
+    }
+
+    //one pointer store, windows started from now on take it
+    sml_blob_slot = slot;
+    sml_blob_sequence = commit.sequence;
+    sml_blob = commit.blob_crc ? blob : NULL;
+    return 0;
+}
+
+void sml_blob_abort(void)
+{
+    sml_upload_slot = -1;
+}
@@ -0,0 +1,70 @@
+#ifndef __SML_BLOB_H__
+#define __SML_BLOB_H__
+#include <stdint.h>
+#include <stdbool.h>
+#include "sml_fixed_model.h"
+
+//Model parameter blob of the fixed point path, written by tools/kp_host/kp_model.py from model.json:
+//the Min Max Scale maxima and the PME patterns, read in place from flash. The feature bins stay built in,
+//a blob is only taken for the bins and harmonics it was generated for.
+
+#define SML_BLOB_MAGIC     0x424C4D53u //"SMLB"
+#define SML_BLOB_VERSION   1
+#define SML_BLOB_SLOT_ROWS 8           //flash rows of each of the two slots, below the sml_learn store
+
+typedef struct {
+    uint32_t magic;     //SML_BLOB_MAGIC
+    uint32_t crc;       //CRC-32 of the blob after this field
+    uint32_t size;      //bytes of the blob, header included
+    uint16_t version;   //SML_BLOB_VERSION
+    uint16_t features;  //SML_FIXED_FEATURES
+    uint16_t patterns;
+    uint16_t window;    //SML_FIXED_WINDOW
+    uint32_t layout;    //CRC-32 of sml_fixed_bin and SML_FIXED_HARMONICS
+    uint8_t uuid[16];   //model.json uuid
+} sml_blob_header_t;
+
+typedef struct {
+    uint16_t category;
+    uint16_t influence;
+    uint8_t vector[SML_FIXED_FEATURES];
+} sml_blob_pattern_t;
+
+typedef struct {
+    sml_blob_header_t header;
+    uint32_t max_mant[SML_FIXED_FEATURES]; //Min Max Scale maximum of each feature, max_mant*2^max_exp
+    int8_t max_exp[SML_FIXED_FEATURES];
+    sml_blob_pattern_t pattern[];
+} sml_blob_t;
+
+//PME result of sml_blob_classify, the output tensor of the library's PME
+typedef struct {
+    uint16_t pattern;
+    uint16_t category;
+    uint16_t influence;
+    uint16_t distance;
+} sml_blob_result_t;
+
+//CRC-32 (zlib) of size bytes continuing crc, 0 to start
+uint32_t sml_crc32(uint32_t crc, const uint8_t *data, uint32_t size);
+
+//at startup: the newest committed slot becomes the active model
+void sml_blob_init(void);
+//active blob, NULL for the built-in model; the caller uses it until the next sml_blob_acquire or
+//sml_blob_release, the store does not erase it meanwhile
+const sml_blob_t *sml_blob_acquire(void);
+void sml_blob_release(void);
+const sml_blob_t *sml_blob_active(void);
+
+//nearest pattern by L1 distance, the first one on a tie (the library's PME), returns its category
+int32_t sml_blob_classify(const sml_blob_t *blob, const uint8_t *feature_vector, sml_blob_result_t *result);
+
+//upload into the inactive slot, one byte at a time, written a page at a time;
+//sml_blob_end checks the blob and commits it, an upload without bytes commits the built-in model
+bool sml_blob_begin(void);
+bool sml_blob_write(uint8_t data);
+//0 committed, -1 no upload, -2 bad blob, -3 flash error
+int32_t sml_blob_end(void);
+void sml_blob_abort(void);
+
+#endif //__SML_BLOB_H__
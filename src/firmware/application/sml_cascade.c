@@ -0,0 +1,84 @@
+#include "sml_cascade.h"
+#include <string.h>
+
+//Beats are the steepest slopes of the raw signal: a beat is detected where the slope over 2 samples passes
+//half its decaying envelope, outside the refractory time of the last beat. Either polarity counts, the
+//BMD101 lead can be placed either way round. An interval outside SML_CASCADE_RR_MIN..SML_CASCADE_RR_MAX
+//means a missed or an extra beat, the screen then leaves the window to the PME.
+
+#if SML_CASCADE_BEATS*SML_CASCADE_RR_MIN <= SML_CASCADE_SPAN
+#error "SML_CASCADE_BEATS does not hold the beats of a span at SML_CASCADE_RR_MIN"
+#endif
+
+void sml_cascade_init(sml_cascade_t *cascade)
+{
+    memset(cascade, 0, sizeof(*cascade));
+}
+
+void sml_cascade_sample(sml_cascade_t *cascade, int16_t sample)
+{
+    int32_t slope = (int32_t)sample - cascade->previous[1];
+    uint32_t level = (uint32_t)(slope < 0 ? -slope : slope) << 8;
+
+    cascade->previous[1] = cascade->previous[0];
+    cascade->previous[0] = sample;
+    cascade->samples++;
+    if (cascade->samples < 3){
+        return;//no slope yet
+    }
+
+    if (level > cascade->envelope){
+        cascade->envelope = level;
+    }
+    else{
+        cascade->envelope -= cascade->envelope >> SML_CASCADE_DECAY;
+    }
+    if (level < (SML_CASCADE_MIN_SLOPE << 8) || 2*level < cascade->envelope){
+        return;
+    }
+    if (cascade->beats && cascade->samples - cascade->beat[(cascade->beats - 1) % SML_CASCADE_BEATS] < SML_CASCADE_REFRACT){
+        return;
+    }
+    cascade->beat[cascade->beats % SML_CASCADE_BEATS] = cascade->samples;
+    cascade->beats++;
+}
+
+int32_t sml_cascade_screen(const sml_cascade_t *cascade, int32_t *irregularity)
+{
+    uint32_t i, count, rr, last = 0, sum = 0, diff = 0;
+    uint32_t first = cascade->beats > SML_CASCADE_BEATS ? cascade->beats - SML_CASCADE_BEATS : 0;
+    int32_t per_mille;
+
+    *irregularity = -1;
+    //intervals of the beats in the span, newest first
+    for (i = cascade->beats, count = 0; i > first + 1; i--){
+        if (cascade->samples - cascade->beat[(i - 2) % SML_CASCADE_BEATS] > SML_CASCADE_SPAN){
+            break;
+        }
+        rr = cascade->beat[(i - 1) % SML_CASCADE_BEATS] - cascade->beat[(i - 2) % SML_CASCADE_BEATS];
+        if (rr < SML_CASCADE_RR_MIN || rr > SML_CASCADE_RR_MAX){
+            return -1;
+        }
+        if (count){
+            diff += rr > last ? rr - last : last - rr;
+        }
+        sum += rr;
+        last = rr;
+        count++;
+    }
+    //a gap since the newest beat is an interval too long to be seen yet
+    if (count < SML_CASCADE_MIN_RR || cascade->samples - cascade->beat[(cascade->beats - 1) % SML_CASCADE_BEATS] > SML_CASCADE_RR_MAX){
+        return -1;
+    }
+
+    //mean successive difference over mean interval
+    per_mille = (int32_t)((diff * 1000 * count) / ((count - 1) * sum));
+    *irregularity = per_mille;
+    if (per_mille <= SML_CASCADE_REGULAR){
+        return SML_CASCADE_NORMAL;
+    }
+    if (per_mille >= SML_CASCADE_IRREGULAR){
+        return SML_CASCADE_AFIB;
+    }
+    return -1;
+}
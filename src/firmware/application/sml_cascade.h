@@ -0,0 +1,49 @@
+#ifndef __SML_CASCADE_H__
+#define __SML_CASCADE_H__
+#include <stdint.h>
+#include <stdbool.h>
+
+//First stage of the cascade: a rhythm screen on the RR intervals of the model input samples, integer only
+//and a few cycles a sample. A window with a clearly regular or clearly irregular rhythm takes the screen's
+//category, any other window escalates to the full feature generation and PME (SML_MODEL_INDEX).
+//Intervals and spans are in model input samples. INFERENCE_INTERVAL (3ms) is polled on the BMD101 raw
+//packets (512Hz), so a sample is taken every second packet: 256Hz, 3.9ms apart.
+
+//categories of the model the screen gives
+#define SML_CASCADE_AFIB      1
+#define SML_CASCADE_NORMAL    2
+
+#define SML_CASCADE_SPAN      1248 //samples of the rhythm looked at (4.9s), ending at the window's screen
+#define SML_CASCADE_BEATS     32   //beats kept, at least the beats of a span at SML_CASCADE_RR_MIN, power of 2
+#define SML_CASCADE_MIN_RR    3    //intervals a span needs, fewer escalate
+#define SML_CASCADE_RR_MIN    77   //shortest interval taken as a beat to beat one (300ms, 200bpm), shorter escalate
+#define SML_CASCADE_RR_MAX    384  //longest one (1.5s, 40bpm), longer is a missed beat and escalates
+#define SML_CASCADE_REFRACT   51   //samples after a beat with no new beat (200ms)
+#define SML_CASCADE_MIN_SLOPE 100  //slope over 2 samples below which no beat is detected, noise floor
+#define SML_CASCADE_DECAY     10   //slope envelope decays by 2^-N a sample
+
+//escalation thresholds: mean successive interval difference per mille of the mean interval
+#define SML_CASCADE_REGULAR   60   //at most: Normal without the PME, 0 escalates every regular window
+#define SML_CASCADE_IRREGULAR 250  //at least: AFib without the PME, 1000 escalates every irregular window
+
+//every Nth screened window also runs the PME; when it disagrees, the next SML_CASCADE_HOLD windows all
+//escalate, so a rhythm the screen misjudges cannot hide what the PME sees
+#define SML_CASCADE_AUDIT     4
+#define SML_CASCADE_HOLD      16
+
+typedef struct {
+    int16_t previous[2];                   //last two samples
+    uint32_t envelope;                     //slope envelope, <<8
+    uint32_t samples;                      //samples since init
+    uint32_t beat[SML_CASCADE_BEATS];      //sample of each recent beat, ring
+    uint32_t beats;                        //beats since init
+} sml_cascade_t;
+
+void sml_cascade_init(sml_cascade_t *cascade);
+//one model input sample to the beat detection
+void sml_cascade_sample(sml_cascade_t *cascade, int16_t sample);
+//category of the rhythm in the last SML_CASCADE_SPAN samples, -1 to escalate;
+//*irregularity gets the per mille difference, -1 without enough intervals
+int32_t sml_cascade_screen(const sml_cascade_t *cascade, int32_t *irregularity);
+
+#endif //__SML_CASCADE_H__
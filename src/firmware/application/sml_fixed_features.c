@@ -0,0 +1,362 @@
+#include "sml_fixed_features.h"
+#include <stdbool.h>
+#include <string.h>
+
+//Fixed point replacement of the knowledge pack feature path for a core without FPU.
+//Every step the library does in float (autoscale, bin magnitude, HPS product, min max scale) is done on
+//integers with the same single precision rounding, so the feature vector is the one the library gives.
+//Only one FFT is run: through the bank modulo of min_max_scale every feature is an HPS bin or 0, the peak
+//HPS and power spectrum FFTs of the library never reach the feature vector. After the FFT only the bins
+//the HPS reads are split and turned into magnitudes.
+
+#define SML_FFT_SIZE   SML_FIXED_SPAN    //real FFT points, the library only uses the first 512 samples
+#define SML_FFT_BINS   (SML_FFT_SIZE/2)  //complex bins
+#define SML_HANN_SHIFT 14                //Q14 Hanning weights
+#define SML_MANT_BITS  24                //significant bits of a single precision float
+
+//1: split and magnitude of all 256 bins, to compare with the specialized path on the host
+#ifndef SML_FIXED_ALL_BINS
+#define SML_FIXED_ALL_BINS 0
+#endif
+
+#if SML_FIXED_WINDOW < SML_FFT_SIZE
+#error "sml_fixed_features needs a model window of at least 512 samples"
+#endif
+
+//sin(2*pi*k/512)*32767 truncated, k = 0..383, the Q15 twiddles of FFTR_512
+static const int16_t sml_sine512[384] = {
+         0,    402,    804,   1206,   1607,   2009,   2410,   2811,   3211,   3611,   4011,   4409,
+      4807,   5205,   5601,   5997,   6392,   6786,   7179,   7571,   7961,   8351,   8739,   9126,
+      9511,   9895,  10278,  10659,  11038,  11416,  11792,  12166,  12539,  12909,  13278,  13645,
+     14009,  14372,  14732,  15090,  15446,  15799,  16150,  16499,  16845,  17189,  17530,  17868,
+     18204,  18537,  18867,  19194,  19519,  19840,  20159,  20474,  20787,  21096,  21402,  21705,
+     22004,  22301,  22594,  22883,  23169,  23452,  23731,  24006,  24278,  24546,  24811,  25072,
+     25329,  25582,  25831,  26077,  26318,  26556,  26789,  27019,  27244,  27466,  27683,  27896,
+     28105,  28309,  28510,  28706,  28897,  29085,  29268,  29446,  29621,  29790,  29955,  30116,
+     30272,  30424,  30571,  30713,  30851,  30984,  31113,  31236,  31356,  31470,  31580,  31684,
+     31785,  31880,  31970,  32056,  32137,  32213,  32284,  32350,  32412,  32468,  32520,  32567,
+     32609,  32646,  32678,  32705,  32727,  32744,  32757,  32764,  32767,  32764,  32757,  32744,
+     32727,  32705,  32678,  32646,  32609,  32567,  32520,  32468,  32412,  32350,  32284,  32213,
+     32137,  32056,  31970,  31880,  31785,  31684,  31580,  31470,  31356,  31236,  31113,  30984,
+     30851,  30713,  30571,  30424,  30272,  30116,  29955,  29790,  29621,  29446,  29268,  29085,
+     28897,  28706,  28510,  28309,  28105,  27896,  27683,  27466,  27244,  27019,  26789,  26556,
+     26318,  26077,  25831,  25582,  25329,  25072,  24811,  24546,  24278,  24006,  23731,  23452,
+     23169,  22883,  22594,  22301,  22004,  21705,  21402,  21096,  20787,  20474,  20159,  19840,
+     19519,  19194,  18867,  18537,  18204,  17868,  17530,  17189,  16845,  16499,  16150,  15799,
+     15446,  15090,  14732,  14372,  14009,  13645,  13278,  12909,  12539,  12166,  11792,  11416,
+     11038,  10659,  10278,   9895,   9511,   9126,   8739,   8351,   7961,   7571,   7179,   6786,
+      6392,   5997,   5601,   5205,   4807,   4409,   4011,   3611,   3211,   2811,   2410,   2009,
+      1607,   1206,    804,    402,      0,   -402,   -804,  -1206,  -1607,  -2009,  -2410,  -2811,
+     -3211,  -3611,  -4011,  -4409,  -4807,  -5205,  -5601,  -5997,  -6392,  -6786,  -7179,  -7571,
+     -7961,  -8351,  -8739,  -9126,  -9511,  -9895, -10278, -10659, -11038, -11416, -11792, -12166,
+    -12539, -12909, -13278, -13645, -14009, -14372, -14732, -15090, -15446, -15799, -16150, -16499,
+    -16845, -17189, -17530, -17868, -18204, -18537, -18867, -19194, -19519, -19840, -20159, -20474,
+    -20787, -21096, -21402, -21705, -22004, -22301, -22594, -22883, -23169, -23452, -23731, -24006,
+    -24278, -24546, -24811, -25072, -25329, -25582, -25831, -26077, -26318, -26556, -26789, -27019,
+    -27244, -27466, -27683, -27896, -28105, -28309, -28510, -28706, -28897, -29085, -29268, -29446,
+    -29621, -29790, -29955, -30116, -30272, -30424, -30571, -30713, -30851, -30984, -31113, -31236,
+    -31356, -31470, -31580, -31684, -31785, -31880, -31970, -32056, -32137, -32213, -32284, -32350,
+    -32412, -32468, -32520, -32567, -32609, -32646, -32678, -32705, -32727, -32744, -32757, -32764
+};
+
+//0.5-0.5*cos(2*pi*i/512) in Q14 for the first half of the 512 point window, as fftr computes it
+static const int16_t sml_hann512[SML_FFT_SIZE/2] = {
+        0,     0,     2,     5,     9,    15,    22,    30,    39,    49,    61,    74,    88,   104,   120,   138,
+      157,   177,   199,   221,   245,   270,   296,   324,   352,   382,   413,   445,   478,   513,   548,   585,
+      623,   662,   702,   744,   786,   830,   874,   920,   967,  1015,  1064,  1114,  1165,  1217,  1270,  1325,
+     1380,  1436,  1494,  1552,  1612,  1672,  1733,  1796,  1859,  1923,  1988,  2055,  2122,  2190,  2258,  2328,
+     2399,  2470,  2543,  2616,  2690,  2765,  2841,  2917,  2995,  3073,  3152,  3231,  3312,  3393,  3474,  3557,
+     3640,  3724,  3809,  3894,  3980,  4067,  4154,  4241,  4330,  4419,  4508,  4598,  4689,  4780,  4872,  4964,
+     5057,  5150,  5243,  5337,  5432,  5527,  5622,  5717,  5813,  5910,  6007,  6104,  6201,  6299,  6397,  6495,
+     6593,  6692,  6791,  6890,  6989,  7089,  7189,  7289,  7389,  7489,  7589,  7689,  7790,  7890,  7990,  8091,
+     8191,  8292,  8393,  8493,  8593,  8694,  8794,  8894,  8994,  9094,  9194,  9294,  9394,  9493,  9592,  9691,
+     9790,  9888,  9986, 10084, 10182, 10279, 10376, 10473, 10570, 10666, 10761, 10856, 10951, 11046, 11140, 11233,
+    11326, 11419, 11511, 11603, 11694, 11785, 11875, 11964, 12053, 12142, 12229, 12316, 12403, 12489, 12574, 12659,
+    12743, 12826, 12909, 12990, 13071, 13152, 13231, 13310, 13388, 13466, 13542, 13618, 13693, 13767, 13840, 13913,
+    13984, 14055, 14125, 14193, 14261, 14328, 14395, 14460, 14524, 14587, 14650, 14711, 14771, 14831, 14889, 14947,
+    15003, 15058, 15113, 15166, 15218, 15269, 15319, 15368, 15416, 15463, 15509, 15553, 15597, 15639, 15681, 15721,
+    15760, 15798, 15835, 15870, 15905, 15938, 15970, 16001, 16031, 16059, 16087, 16113, 16138, 16162, 16184, 16206,
+    16226, 16245, 16263, 16279, 16295, 16309, 16322, 16334, 16344, 16353, 16361, 16368, 16374, 16378, 16381, 16383
+};
+
+//Min Max Scale maxima in use, read in place
+static const uint32_t *sml_max_mant = sml_fixed_max_mant;
+static const int8_t *sml_max_exp = sml_fixed_max_exp;
+
+//round x to 24 significant bits, nearest even, as the FPU does. *exp is raised by the bits dropped
+static uint32_t sml_round24(uint64_t x, int32_t *exp)
+{
+    uint32_t high = (uint32_t)(x >> SML_MANT_BITS);
+    int32_t shift = high ? 32 - __builtin_clz(high) : 0;
+    uint64_t rest, half;
+
+    if (shift){
+        rest = x & (((uint64_t)1 << shift) - 1);
+        half = (uint64_t)1 << (shift - 1);
+        x >>= shift;
+        if (rest > half || (rest == half && (x & 1))){
+            x++;
+        }
+        if (x >> SML_MANT_BITS){
+            x >>= 1;
+            shift++;
+        }
+    }
+    *exp += shift;
+    return (uint32_t)x;
+}
+
+//integer value below 2^32 as it is after conversion to float
+static uint32_t sml_float_int(uint32_t x)
+{
+    int32_t exp = 0;
+    uint32_t mant = sml_round24(x, &exp);
+    return mant << exp;
+}
+
+static uint32_t sml_isqrt(uint32_t x)
+{
+    uint32_t root = 0, bit = 1UL << 30;
+
+    while (bit > x){
+        bit >>= 2;
+    }
+    while (bit){
+        if (x >= root + bit){
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else{
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+static uint8_t sml_bit_reverse(uint8_t x)
+{
+    x = (uint8_t)((x >> 4) | (x << 4));
+    x = (uint8_t)(((x & 0xCC) >> 2) | ((x & 0x33) << 2));
+    return (uint8_t)(((x & 0xAA) >> 1) | ((x & 0x55) << 1));
+}
+
+//FFTR_512 of the library, complex part: radix-2 FFT of the 256 sample pairs, each stage scaled by 1/2.
+//The radix and rounding are kept, a radix-4 FFT would round differently and change the features.
+static void sml_fft256(int16_t *c)
+{
+    int16_t t;
+    int32_t i, j, k, len, stage;
+
+    for (i = 1; i < SML_FFT_BINS - 1; i++){
+        j = sml_bit_reverse((uint8_t)i);
+        if (j > i){
+            t = c[2*i];   c[2*i]   = c[2*j];   c[2*j]   = t;
+            t = c[2*i+1]; c[2*i+1] = c[2*j+1]; c[2*j+1] = t;
+        }
+    }
+
+    for (len = 1, stage = 0; len < SML_FFT_BINS; len <<= 1, stage++){
+        for (j = 0; j < len; j++){
+            int32_t idx = j << (8 - stage);
+            int32_t wr = sml_sine512[idx + 128];
+            int32_t wi = (int16_t)-sml_sine512[idx];
+
+            for (k = j; k < SML_FFT_BINS; k += 2*len){
+                int32_t rh = c[2*(k+len)] >> 1, ih = c[2*(k+len)+1] >> 1;
+                int32_t r1 = c[2*k] >> 1,       i1 = c[2*k+1] >> 1;
+                int32_t a  = (wi*ih + 1) >> 15;
+                int32_t b  = (wr*rh + 1) >> 15;
+                int32_t ti = ((wr*ih + 1) >> 15) + ((wi*rh + 1) >> 15);
+
+                c[2*(k+len)]   = (int16_t)(r1 + a - b);
+                c[2*(k+len)+1] = (int16_t)(i1 - ti);
+                c[2*k+1]       = (int16_t)(ti + i1);
+                c[2*k]         = (int16_t)(r1 + b - a);
+            }
+        }
+    }
+}
+
+//FFTR_512 of the library, real split: bins k and 256-k of the real input's spectrum from the complex
+//bins k and 256-k. Each pair only touches its own bins, bins 0 and 128 stay as they are.
+static void sml_split(int16_t *c, int32_t k)
+{
+    int32_t nwr = (int16_t)-sml_sine512[128 + k];
+    int32_t wi  = sml_sine512[256 + k];
+    int32_t ar = c[2*k] >> 1,   br = c[2*(SML_FFT_BINS-k)] >> 1;
+    int32_t ai = c[2*k+1] >> 1, nb = (-c[2*(SML_FFT_BINS-k)+1]) >> 1;
+    int32_t s = ar + br, p = ai + nb;
+    int32_t q = (int16_t)(ai - nb), d = (int16_t)(ar - br);
+    int32_t x = (wi*d + 1) >> 15;
+    int32_t y = (nwr*q + 1) >> 15;
+    int32_t tim = ((wi*q + 1) >> 15) + ((nwr*d + 1) >> 15);
+
+    c[2*k]                  = (int16_t)(s + x - y);
+    c[2*k+1]                = (int16_t)(p + tim);
+    c[2*(SML_FFT_BINS-k)]   = (int16_t)(s - x + y);
+    c[2*(SML_FFT_BINS-k)+1] = (int16_t)(tim - p);
+}
+
+static void sml_remove_mean(int16_t *data)
+{
+    int32_t sum = 0, i;
+
+    for (i = 0; i < SML_FFT_SIZE; i++){
+        sum += data[i];
+    }
+    sum /= SML_FFT_SIZE;
+    for (i = 0; i < SML_FFT_SIZE; i++){
+        data[i] = (int16_t)((uint16_t)data[i] - (uint16_t)sum);
+    }
+}
+
+static void sml_hanning(int16_t *data)
+{
+    int32_t i;
+
+    for (i = 0; i < SML_FFT_SIZE/2; i++){
+        data[i] = (int16_t)((data[i]*sml_hann512[i] + 1) >> SML_HANN_SHIFT);
+        data[SML_FFT_SIZE-1-i] = (int16_t)((data[SML_FFT_SIZE-1-i]*sml_hann512[i] + 1) >> SML_HANN_SHIFT);
+    }
+}
+
+//autoscale to full range: x*(32767.0f/peak) truncated, with the float quotient and product rounding
+static void sml_autoscale(int16_t *data)
+{
+    int32_t min = 32767, max = -32768, peak, exp = 0, e, i;
+    uint32_t scale, rest, mant, mag;
+    uint64_t num;
+
+    for (i = 0; i < SML_FFT_SIZE; i++){
+        if (data[i] < min) min = data[i];
+        if (data[i] > max) max = data[i];
+    }
+    if (-min > max) peak = -min;
+    else if (max == 0) return;
+    else peak = max;
+    if (peak >= 32767){
+        return;//scale not above 1.0f
+    }
+
+    //scale = mant*2^(exp-23), mant 24 bits
+    while ((peak << (exp + 1)) <= 32767){
+        exp++;
+    }
+    num = (uint64_t)32767 << (SML_MANT_BITS - 1 - exp);
+    scale = (uint32_t)(num / (uint32_t)peak);
+    rest = (uint32_t)(num % (uint32_t)peak);
+    if (2*rest > (uint32_t)peak || (2*rest == (uint32_t)peak && (scale & 1))){
+        scale++;
+    }
+    if (scale >> SML_MANT_BITS){
+        scale >>= 1;
+        exp++;
+    }
+
+    for (i = 0; i < SML_FFT_SIZE; i++){
+        mag = (uint32_t)(data[i] < 0 ? -data[i] : data[i]);
+        e = exp - (SML_MANT_BITS - 1);
+        mant = sml_round24((uint64_t)mag*scale, &e);
+        mag = e >= 0 ? mant << e : mant >> -e;
+        data[i] = (int16_t)(data[i] < 0 ? -(int32_t)mag : (int32_t)mag);
+    }
+}
+
+//magnitude of bin j in place: (int16_t)sqrt(im*im + re*re) with the float rounding of the squares and the
+//sum, all of them below 2^31. Bins are done in ascending order, bin j only overwrites data read before.
+static void sml_magnitude(int16_t *data, int32_t j)
+{
+    int32_t re = data[2*j], im = data[2*j+1];
+    uint32_t sum;
+
+    sum = sml_float_int((uint32_t)(re*re)) + sml_float_int((uint32_t)(im*im));
+    data[j] = (int16_t)sml_isqrt(sml_float_int(sum));
+}
+
+//min_max_scale of the HPS product at bin, min 0 and bounds 0..255:
+//(uint8_t)(float)((double)(p*255.0f)/max), p the float product of the harmonic magnitudes
+static uint8_t sml_hps_feature(const int16_t *mag, int32_t bin, int32_t feature)
+{
+    uint32_t mant = 1;
+    int32_t exp = 0, d, h, m, level;
+    uint64_t num, den, k, rest;
+    bool negative = false;
+
+    //the product in mant*2^exp, up to 2^60 for 15 bit magnitudes
+    for (h = 1; h < SML_FIXED_HARMONICS; h++){
+        m = mag[h*bin];
+        if (m < 0){
+            negative = !negative;
+            m = -m;
+        }
+        mant = sml_round24((uint64_t)mant*(uint32_t)m, &exp);
+    }
+    if (negative || mant == 0){
+        return 0;//clamped to the min bound
+    }
+    mant = sml_round24((uint64_t)mant*255, &exp);
+    while (!(mant >> (SML_MANT_BITS - 1))){
+        mant <<= 1;
+        exp--;
+    }
+
+    //k = floor(p*255/max), both mantissas in [2^23, 2^24)
+    d = exp - sml_max_exp[feature];
+    if (d >= 9){
+        return 255;
+    }
+    if (d <= -26){
+        return 0;
+    }
+    num = (uint64_t)mant << (d > 0 ? d : 0);
+    den = (uint64_t)sml_max_mant[feature] << (d < 0 ? -d : 0);
+    k = num / den;
+    rest = num % den;
+    if (k >= 255){
+        return 255;
+    }
+    //the quotient becomes k+1 as a float when it is within half a float step of it
+    for (level = -1; (k >> (level + 1)) != 0; level++);
+    if (rest && den - rest <= (den >> (SML_MANT_BITS - level))){
+        k++;
+    }
+    return (uint8_t)k;
+}
+
+void sml_fixed_scale(const uint32_t *max_mant, const int8_t *max_exp)
+{
+    sml_max_mant = max_mant ? max_mant : sml_fixed_max_mant;
+    sml_max_exp = max_exp ? max_exp : sml_fixed_max_exp;
+}
+
+void sml_fixed_features(const int16_t *window, int16_t *work, uint8_t *feature_vector)
+{
+    int32_t i;
+
+    memcpy(work, window, SML_FFT_SIZE * sizeof(int16_t));
+    sml_remove_mean(work);
+    sml_hanning(work);
+    sml_autoscale(work);
+    sml_fft256(work);
+#if SML_FIXED_ALL_BINS
+    for (i = 1; i < SML_FFT_BINS/2; i++){
+        sml_split(work, i);
+    }
+    for (i = 0; i < SML_FFT_BINS; i++){
+        sml_magnitude(work, i);
+    }
+#else
+    //only the split pairs and magnitudes of the bins the features read, listed by kp_model.py
+    for (i = 0; i < SML_FIXED_SPLITS; i++){
+        sml_split(work, sml_fixed_split[i]);
+    }
+    for (i = 0; i < SML_FIXED_MAGNITUDES; i++){
+        sml_magnitude(work, sml_fixed_mag_bin[i]);
+    }
+#endif
+
+    for (i = 0; i < SML_FIXED_FEATURES; i++){
+        feature_vector[i] = sml_fixed_bin[i] ? sml_hps_feature(work, sml_fixed_bin[i], i) : 0;
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef __SML_FIXED_FEATURES_H__
+#define __SML_FIXED_FEATURES_H__
+#include <stdint.h>
+#include "sml_fixed_model.h"
+
+//leading samples of the window the features read, the features of a window are final once these are in
+#define SML_FIXED_SPAN 512
+
+//integer only feature vector of one window, the same bytes kb_feature_generation + kb_feature_transform
+//give for it, ready for kb_set_feature_vector / kb_recognize_feature_vector; work is the FFT work area of
+//SML_FIXED_SPAN samples, free again on return
+void sml_fixed_features(const int16_t *window, int16_t *work, uint8_t *feature_vector);
+//Min Max Scale maxima of the next sml_fixed_features, max_mant*2^max_exp with max_mant in [2^23, 2^24),
+//NULL for sml_fixed_max_mant/sml_fixed_max_exp of sml_fixed_model.h
+void sml_fixed_scale(const uint32_t *max_mant, const int8_t *max_exp);
+
+#endif //__SML_FIXED_FEATURES_H__
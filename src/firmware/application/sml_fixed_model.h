@@ -0,0 +1,47 @@
+//Generated by kp_model.py from model.json, do not edit
+//Model TEST_1_RANK_0, uuid 43350e73-bd44-4a53-92ff-0a3e8fd92ff4
+#ifndef __SML_FIXED_MODEL_H__
+#define __SML_FIXED_MODEL_H__
+
+#define SML_FIXED_WINDOW    1248
+#define SML_FIXED_HARMONICS 5
+#define SML_FIXED_FEATURES  24
+#define SML_FIXED_MAGNITUDES 65
+#define SML_FIXED_SPLITS    62
+
+//HPS bin each feature reads through the feature bank, 0 for a slot that is never written
+static const uint8_t sml_fixed_bin[SML_FIXED_FEATURES] = {
+    14, 0, 0, 0, 0, 1, 2, 6, 8, 11, 12, 16,
+    17, 21, 27, 29, 31, 34, 39, 41, 42, 46, 49, 50
+};
+
+//FFT bins the HPS of those bins reads, harmonics 1..4, ascending
+static const uint8_t sml_fixed_mag_bin[SML_FIXED_MAGNITUDES] = {
+    1, 2, 3, 4, 6, 8, 11, 12, 14, 16, 17, 18, 21, 22, 24, 27,
+    28, 29, 31, 32, 33, 34, 36, 39, 41, 42, 44, 46, 48, 49, 50, 51,
+    54, 56, 58, 62, 63, 64, 68, 78, 81, 82, 84, 87, 92, 93, 98, 100,
+    102, 108, 116, 117, 123, 124, 126, 136, 138, 147, 150, 156, 164, 168, 184, 196,
+    200
+};
+
+//k of the real FFT split pairs (k, 256-k) holding them
+static const uint8_t sml_fixed_split[SML_FIXED_SPLITS] = {
+    1, 2, 3, 4, 6, 8, 11, 12, 14, 16, 17, 18, 21, 22, 24, 27,
+    28, 29, 31, 32, 33, 34, 36, 39, 41, 42, 44, 46, 48, 49, 50, 51,
+    54, 56, 58, 60, 62, 63, 64, 68, 72, 78, 81, 82, 84, 87, 88, 92,
+    93, 98, 100, 102, 106, 108, 109, 116, 117, 118, 120, 123, 124, 126
+};
+
+//Min Max Scale maximum of each feature, mant*2^exp as the float in model.json
+static const uint32_t sml_fixed_max_mant[SML_FIXED_FEATURES] = {
+    0x872491, 0xe711d8, 0x89221c, 0x9fb801, 0xb70bb9, 0xda05cf,
+    0x824b55, 0x86f6b4, 0xc792a0, 0xb9d4c2, 0xd9f08c, 0xb8a231,
+    0x90e23a, 0xd02566, 0x97b8b6, 0xb79989, 0xba2ab2, 0xfd5c3f,
+    0xeff5f5, 0xa8ff35, 0xa08895, 0xe6a09e, 0xab1404, 0xb847cb
+};
+static const int8_t sml_fixed_max_exp[SML_FIXED_FEATURES] = {
+    18, 22, 18, 16, 15, 15, 16, 14, 13, 13, 13, 12,
+    13, 11, 11, 12, 10, 7, -19, -19, -19, -20, -19, -19
+};
+
+#endif //__SML_FIXED_MODEL_H__
@@ -0,0 +1,221 @@
+#include "../mplabml/inc/kb.h"
+#include "definitions.h"
+#include "sml_learn.h"
+#include "sml_recognition_run.h"
+#include "sml_blob.h"
+#include <stddef.h>
+#include <string.h>
+
+//Per-user adaptation of the PME patterns. A labeled window replaces the nearest trained pattern of its
+//category and the table goes to flash as a record of one row. Records are written to the rows in turn,
+//so each row is erased once every SML_STORE_ROWS saves and the previous record stays intact until the
+//next row is reused. The newest record with a good CRC and the model's UUID wins at load.
+
+#define SML_MODEL           SML_MODEL_INDEX
+#define SML_STORE_ADDRESS   (FLASH_ADDR+FLASH_SIZE-SML_STORE_ROWS*NVMCTRL_FLASH_ROWSIZE)
+#define SML_STORE_MAGIC     0x4E525450u //"PTRN"
+#define SML_UUID_SIZE       16
+
+typedef struct {
+    uint16_t category;
+    uint16_t influence;
+    uint8_t vector[SML_PME_FEATURES];
+} sml_pattern_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence; //counts saves, the highest one is the newest record
+    uint32_t crc;      //CRC-32 of the record after this field
+    uint8_t uuid[SML_UUID_SIZE];
+    uint16_t count;
+    uint16_t length;
+    sml_pattern_t pattern[SML_PME_PATTERNS];
+} sml_store_t;
+
+#define SML_STORE_CRC_OFFSET offsetof(sml_store_t, uuid)
+
+static sml_pattern_t sml_trained[SML_PME_PATTERNS]; //table the knowledge pack was built with
+static int32_t sml_trained_count = 0;                //0: learning off
+static int32_t sml_store_row = -1;                   //row of the newest record, -1 none
+static uint32_t sml_store_sequence = 0;
+
+//PME table as it is now, returns the patterns
+static int32_t sml_learn_table(sml_pattern_t *table)
+{
+    pme_model_header_t header;
+    pme_pattern_t pattern;
+    int32_t i;
+
+    kb_get_model_header(SML_MODEL, &header);
+    if (header.number_patterns > SML_PME_PATTERNS){
+        return 0;
+    }
+    for (i = 0; i < header.number_patterns; i++){
+        kb_get_model_pattern(SML_MODEL, i, &pattern);
+        table[i].category = pattern.category;
+        table[i].influence = pattern.influence;
+        memcpy(table[i].vector, pattern.vector, SML_PME_FEATURES);
+    }
+    return header.number_patterns;
+}
+
+static void sml_learn_apply(const sml_pattern_t *table, int32_t count)
+{
+    int32_t i;
+
+    //the library copies the vector, a table in flash can be given as it is
+    kb_flush_model(SML_MODEL);
+    for (i = 0; i < count; i++){
+        kb_add_custom_pattern_to_model(SML_MODEL, (uint8_t *)table[i].vector, table[i].category, table[i].influence);
+    }
+}
+
+static bool sml_store_valid(const sml_store_t *store)
+{
+    if (store->count == 0 || store->count > sml_trained_count || store->length != SML_PME_FEATURES){
+        return false;
+    }
+    if (memcmp(store->uuid, kb_get_model_uuid_ptr(SML_MODEL), SML_UUID_SIZE) != 0){
+        return false;//learned on another knowledge pack
+    }
+    return store->crc == sml_crc32(0, (const uint8_t *)store + SML_STORE_CRC_OFFSET,
+                                   sizeof(sml_store_t) - SML_STORE_CRC_OFFSET);
+}
+
+int32_t sml_learn_load(void)
+{
+    pme_model_header_t header;
+    const sml_store_t *store;
+    const sml_store_t *newest;
+    uint32_t rejected = 0;
+    int32_t row, newest_row = -1;
+
+    kb_get_model_header(SML_MODEL, &header);
+    if (header.pattern_length != SML_PME_FEATURES || header.number_patterns > SML_PME_PATTERNS){
+        sml_trained_count = 0;
+        return -1;
+    }
+    sml_trained_count = sml_learn_table(sml_trained);
+
+    //only the magic and sequence of each row are read, the CRC only of the record that is used;
+    //a record cut by reset fails it and the one before is taken
+    for (;;){
+        newest = NULL;
+        for (row = 0; row < SML_STORE_ROWS; row++){
+            store = (const sml_store_t *)(SML_STORE_ADDRESS + row * NVMCTRL_FLASH_ROWSIZE);
+            if ((rejected & (1u << row)) || store->magic != SML_STORE_MAGIC){
+                continue;
+            }
+            if (newest == NULL || (int32_t)(store->sequence - newest->sequence) > 0){
+                newest = store;
+                newest_row = row;
+            }
+        }
+        if (newest == NULL){
+            return 0;
+        }
+        if (sml_store_valid(newest)){
+            break;
+        }
+        rejected |= 1u << newest_row;
+    }
+
+    sml_store_row = newest_row;
+    sml_store_sequence = newest->sequence;
+    sml_learn_apply(newest->pattern, newest->count);
+    return newest->count;
+}
+
+int32_t sml_learn_add(uint16_t category)
+{
+    sml_pattern_t table[SML_PME_PATTERNS];
+    feature_vector_t *fv = get_feature_vector_pointer(SML_MODEL);
+    const uint8_t *vector = (const uint8_t *)fv->data;
+    int32_t count, i, j, dist, best = INT32_MAX, slot = -1;
+
+    if (sml_trained_count == 0 || fv->size != SML_PME_FEATURES){
+        return -1;
+    }
+    count = sml_learn_table(table);
+    for (i = 0; i < count; i++){
+        if (table[i].category != category){
+            continue;
+        }
+        for (j = 0, dist = 0; j < SML_PME_FEATURES; j++){
+            dist += (table[i].vector[j] > vector[j]) ? table[i].vector[j] - vector[j] : vector[j] - table[i].vector[j];
+        }
+        if (dist < best){
+            best = dist;
+            slot = i;
+        }
+    }
+    if (slot < 0){
+        return -1;
+    }
+    //the influence field of the replaced pattern is kept
+    memcpy(table[slot].vector, vector, SML_PME_FEATURES);
+    sml_learn_apply(table, count);
+    return slot;
+}
+
+bool sml_learn_save(void)
+{
+    sml_store_t store;
+    uint32_t page[NVMCTRL_FLASH_PAGESIZE / 4];
+    uint32_t address, offset, size;
+    int32_t row = (sml_store_row + 1) % SML_STORE_ROWS;
+
+    if (sml_trained_count == 0){
+        return false;
+    }
+    memset(&store, 0, sizeof(store));
+    store.magic = SML_STORE_MAGIC;
+    store.sequence = sml_store_sequence + 1;
+    memcpy(store.uuid, kb_get_model_uuid_ptr(SML_MODEL), SML_UUID_SIZE);
+    store.count = (uint16_t)sml_learn_table(store.pattern);
+    store.length = SML_PME_FEATURES;
+    store.crc = sml_crc32(0, (const uint8_t *)&store + SML_STORE_CRC_OFFSET, sizeof(store) - SML_STORE_CRC_OFFSET);
+
+    //the CPU stalls on flash reads while the row is erased and the pages are written
+    address = SML_STORE_ADDRESS + row * NVMCTRL_FLASH_ROWSIZE;
+    while (NVMCTRL_IsBusy());
+    NVMCTRL_RowErase(address);
+    while (NVMCTRL_IsBusy());
+    for (offset = 0; offset < sizeof(store); offset += NVMCTRL_FLASH_PAGESIZE){
+        size = sizeof(store) - offset;
+        if (size > NVMCTRL_FLASH_PAGESIZE){
+            size = NVMCTRL_FLASH_PAGESIZE;
+        }
+        memset(page, 0xFF, sizeof(page));
+        memcpy(page, (const uint8_t *)&store + offset, size);
+        NVMCTRL_PageWrite(page, address + offset);
+        while (NVMCTRL_IsBusy());
+    }
+    NVMCTRL_CacheInvalidate();
+
+    if (NVMCTRL_ErrorGet() != NVMCTRL_ERROR_NONE || memcmp((const void *)address, &store, sizeof(store)) != 0){
+        return false;
+    }
+    sml_store_row = row;
+    sml_store_sequence = store.sequence;
+    return true;
+}
+
+bool sml_learn_forget(void)
+{
+    int32_t row;
+
+    if (sml_trained_count == 0){
+        return false;
+    }
+    for (row = 0; row < SML_STORE_ROWS; row++){
+        while (NVMCTRL_IsBusy());
+        NVMCTRL_RowErase(SML_STORE_ADDRESS + row * NVMCTRL_FLASH_ROWSIZE);
+    }
+    while (NVMCTRL_IsBusy());
+    NVMCTRL_CacheInvalidate();
+    sml_store_row = -1;
+    sml_store_sequence = 0;
+    sml_learn_apply(sml_trained, sml_trained_count);
+    return NVMCTRL_ErrorGet() == NVMCTRL_ERROR_NONE;
+}
@@ -0,0 +1,26 @@
+#ifndef __SML_LEARN_H__
+#define __SML_LEARN_H__
+#include <stdint.h>
+#include <stdbool.h>
+
+//pattern slots of the knowledge pack PME table and features of a pattern, the library allocates the
+//table for the trained patterns only, so learning replaces patterns instead of adding slots
+#define SML_PME_PATTERNS 4
+#define SML_PME_FEATURES 24
+
+//flash rows at the top of the 256KB flash keeping the learned table, one record per row written in turn,
+//the linker ROM_LENGTH (0x3E800) keeps them and the sml_blob slots below them out of the image
+#define SML_STORE_ROWS   8
+
+//after kb_model_init: keeps the trained table and loads the newest stored one into the PME,
+//returns the patterns loaded, 0 when nothing is stored, -1 when the PME table does not fit learning
+int32_t sml_learn_load(void);
+//the feature vector of the last classified window replaces the nearest pattern of category,
+//returns the pattern index, -1 when there is no pattern of category
+int32_t sml_learn_add(uint16_t category);
+//PME table to the next store row, false on flash error
+bool sml_learn_save(void);
+//erases the store and puts the trained table back
+bool sml_learn_forget(void);
+
+#endif //__SML_LEARN_H__
@@ -1,21 +1,169 @@
 #include "../mplabml/inc/kb.h"
-#include "../mplabml/inc/kb_output.h"
+#include "sml_recognition_run.h"
+#include "app_memory.h"
 #include <string.h>
 #ifdef SML_USE_TEST_DATA
 #include "testdata.h"
 int32_t td_index = 0;
 #endif // SML_USE_TEST_DATA
 
-#define SERIAL_OUT_CHARS_MAX 512
+static sml_result_t sml_last;
 
-static char serial_out_buf[SERIAL_OUT_CHARS_MAX];
+#if SML_FIXED_POINT
+#if SML_FIXED_WINDOW != SML_SEGMENT_SIZE
+#error "sml_fixed_model.h is not from this model.json, run tools/kp_host/kp_model.py"
+#endif
+#include "sml_blob.h"
+static uint8_t sml_feature_vector[SML_FIXED_FEATURES];
+static const sml_blob_t *sml_model = NULL;//parameter blob of the window, NULL for the built-in model
+static sml_blob_result_t sml_model_result;
+#endif
 
-void sml_output_results(uint16_t model, uint16_t classification)
+#if SML_CASCADE
+#include "sml_cascade.h"
+static sml_cascade_t sml_cascade;
+static sml_cascade_stats_t sml_cascade_count;
+static uint32_t sml_cascade_hold = 0;  //windows left that escalate after an audit disagreed
+static int32_t sml_cascade_audit = -1; //screen category of a window the PME checks, -1 none
+#endif
+
+#if SML_PROFILER && SML_FIXED_POINT
+#include "main.h"
+//CPU_GetCycles of the fixed point features and of the PME of the last window
+static uint32_t sml_fixed_feature_cycles;
+static uint32_t sml_fixed_classifier_cycles;
+#elif SML_PROFILER
+//family of each generator of the knowledge pack, in feature bank order
+#define SML_GENERATORS 4
+static const uint8_t sml_generator_family[SML_GENERATORS] = {
+    SML_FAMILY_HPS, SML_FAMILY_HPS, SML_FAMILY_PEAK_HPS, SML_FAMILY_POWER
+};
+#endif
+
+//PME output tensor value, clamped to the record field
+static uint16_t sml_tensor_value(float value)
+{
+    return value <= 0.0f ? 0 : value >= 65535.0f ? 0xFFFF : (uint16_t)value;
+}
+
+//keep the result numbers, the caller sends them on; no text is formatted on the target
+static void sml_output_results(uint16_t model)
+{
+    model_results_t *info;
+    feature_vector_t *fv;
+
+#if SML_CASCADE
+    if (sml_cascade_count.last_screened){
+        //no PME output tensor, the screen's irregularity instead
+        memset(&sml_last, 0, sizeof(sml_last));
+        sml_last.source = SML_SOURCE_SCREEN;
+        sml_last.distance = (uint16_t)sml_cascade_count.irregularity;
+        return;
+    }
+#endif
+#if SML_FIXED_POINT
+    if (sml_model != NULL){
+        sml_last.source = SML_SOURCE_BLOB;
+        sml_last.features = SML_FIXED_FEATURES;
+        sml_last.vector = sml_feature_vector;
+        sml_last.pattern = (uint8_t)sml_model_result.pattern;
+        sml_last.influence = sml_model_result.influence;
+        sml_last.distance = sml_model_result.distance;
+        return;
+    }
+#endif
+    //the library's vector, set by kb_set_feature_vector on the SML_FIXED_POINT path
+    fv = get_feature_vector_pointer(model);
+    sml_last.features = fv->size;
+    sml_last.vector = (const uint8_t *)fv->data;
+    //pattern, category, influence and distance, as kb_sprint_model_result prints them
+    info = kb_get_model_result_info(model);
+    sml_last.source = SML_SOURCE_PME;
+    sml_last.pattern = (uint8_t)sml_tensor_value(info->output_tensor->data[0]);
+    sml_last.influence = sml_tensor_value(info->output_tensor->data[2]);
+    sml_last.distance = sml_tensor_value(info->output_tensor->data[3]);
+}
+
+#if SML_CASCADE
+//first stage: true with *category when the rhythm screen decides the window alone
+static bool sml_cascade_first(int32_t *category)
+{
+    int32_t screen = sml_cascade_screen(&sml_cascade, &sml_cascade_count.irregularity);
+
+    sml_cascade_audit = -1;
+    if (sml_cascade_hold){
+        sml_cascade_hold--;
+        return false;
+    }
+    if (screen < 0){
+        return false;
+    }
+    //every SML_CASCADE_AUDIT-th decision is checked by the PME
+    if ((sml_cascade_count.screened + sml_cascade_count.audits + 1) % SML_CASCADE_AUDIT == 0){
+        sml_cascade_audit = screen;
+        sml_cascade_count.audits++;
+        return false;
+    }
+    sml_cascade_count.windows++;
+    sml_cascade_count.screened++;
+    sml_cascade_count.last_screened = true;
+    *category = screen;
+    return true;
+}
+
+//second stage result of an escalated window
+static void sml_cascade_second(int32_t category)
+{
+    sml_cascade_count.windows++;
+    sml_cascade_count.last_screened = false;
+    if (sml_cascade_audit >= 0 && category != sml_cascade_audit){
+        sml_cascade_count.disagreed++;
+        sml_cascade_hold = SML_CASCADE_HOLD;
+    }
+}
+#endif
+
+#if SML_FIXED_POINT
+//feature vector of a window with the maxima of the blob active when the window starts
+static void sml_fixed_window(int16_t *segment)
 {
-    memset(serial_out_buf, 0, SERIAL_OUT_CHARS_MAX);
-    kb_sprint_model_result(model, serial_out_buf, false, false, true);
-    printf("%s\n", serial_out_buf);
+#if SML_PROFILER
+    uint32_t start;
+#endif
+
+    sml_model = sml_blob_acquire();
+    sml_fixed_scale(sml_model ? sml_model->max_mant : NULL, sml_model ? sml_model->max_exp : NULL);
+#if SML_PROFILER
+    start = CPU_GetCycles();
+#endif
+    sml_fixed_features(segment, APP_MemoryScratch.Fft, sml_feature_vector);
+#if SML_PROFILER
+    sml_fixed_feature_cycles = CPU_GetCycles() - start;
+#endif
+}
+
+//PME of the window, in place on the blob patterns or by the library on its own
+static int32_t sml_fixed_classify(void)
+{
+    int32_t ret;
+#if SML_PROFILER
+    uint32_t start = CPU_GetCycles();
+#endif
+
+    if (sml_model != NULL){
+        ret = sml_blob_classify(sml_model, sml_feature_vector, &sml_model_result);
+    }
+    else {
+        //PME only, the vector is already scaled
+        kb_set_feature_vector(SML_MODEL_INDEX, sml_feature_vector);
+        ret = kb_recognize_feature_vector(SML_MODEL_INDEX);
+    }
+#if SML_PROFILER
+    sml_fixed_classifier_cycles = CPU_GetCycles() - start;
+#endif
+    return ret;
 }
+#endif
 
 int32_t sml_recognition_run(int16_t *data, int32_t num_sensors, bool initialize)
 {
@@ -23,17 +171,182 @@ int32_t sml_recognition_run(int16_t *data, int32_t num_sensors, bool initialize)
     if(initialize==true){
         //initialize the model input buffer
         kb_reset_model(0);
+#if SML_FIXED_POINT
+        sml_blob_release();
+#endif
+#if SML_CASCADE
+        sml_cascade_init(&sml_cascade);
+        memset(&sml_cascade_count, 0, sizeof(sml_cascade_count));
+        sml_cascade_count.irregularity = -1;
+        sml_cascade_hold = 0;
+        sml_cascade_audit = -1;
+#endif
         ret=-1;
     }
     else
     {
         //once the data points is sufficient for model input, it will return 1 ot 0, otherwise, it will return negative value
-        ret = kb_run_model((int16_t *)data, num_sensors, KB_MODEL_TEST_1_RANK_0_INDEX);
+        ret = kb_run_model((int16_t *)data, num_sensors, SML_MODEL_INDEX);
         if (ret >= 0){
-            sml_output_results(KB_MODEL_TEST_1_RANK_0_INDEX, ret);
+            sml_output_results(SML_MODEL_INDEX);
             //once the model complete one inference, it will initialize the model
             kb_reset_model(0);
         };
     }
     return ret;//return the value of model inference
 }
+
+int32_t sml_segment_run(int16_t *segment, int32_t size)
+{
+    int32_t ret;
+#if SML_CASCADE
+    if (sml_cascade_first(&ret)){
+        sml_output_results(SML_MODEL_INDEX);
+        kb_reset_model(0);
+        return ret;
+    }
+#endif
+#if SML_FIXED_POINT
+    //the caller filled a whole window, the library only classifies its feature vector
+    (void)size;
+    sml_fixed_window(segment);
+    ret = sml_fixed_classify();
+#else
+    //the caller filled a whole window, hand it over as the model ring buffer and run the pipeline once
+    //(no sensor transform, segmentation check only on the full window)
+    kb_add_segment((uint16_t *)segment, size, 1, SML_MODEL_INDEX);
+    ret = kb_run_segment(SML_MODEL_INDEX);
+#endif
+    if (ret >= 0){
+#if SML_CASCADE
+        sml_cascade_second(ret);
+#endif
+        sml_output_results(SML_MODEL_INDEX);
+        //the next window is registered again by the next call
+        kb_reset_model(0);
+    }
+    return ret;//return the value of model inference
+}
+
+int32_t sml_segment_step(int16_t *segment, int32_t size, int32_t *stage)
+{
+    static int32_t ret;
+    //same pipeline as kb_run_segment, one stage per call so the caller can spread the window over several passes
+    switch (*stage){
+#if SML_FIXED_POINT
+    case SML_STAGE_SEGMENTATION:
+        //the window is the segment, nothing to check
+        (void)size;
+        *stage = SML_STAGE_FEATURES;
+        return -1;
+    case SML_STAGE_FEATURES:
+#if SML_CASCADE
+        if (sml_cascade_first(&ret)){
+            *stage = SML_STAGE_OUTPUT;
+            return -1;
+        }
+#endif
+        sml_fixed_window(segment);
+        *stage = SML_STAGE_CLASSIFY;
+        return -1;
+    case SML_STAGE_CLASSIFY:
+        ret = sml_fixed_classify();
+#else
+    case SML_STAGE_SEGMENTATION:
+        kb_add_segment((uint16_t *)segment, size, 1, SML_MODEL_INDEX);
+        if (kb_segmentation(SML_MODEL_INDEX) == 1){
+            *stage = SML_STAGE_FEATURES;
+            return -1;
+        }
+        ret = -2;//segment filtered
+        break;
+    case SML_STAGE_FEATURES:
+#if SML_CASCADE
+        if (sml_cascade_first(&ret)){
+            *stage = SML_STAGE_OUTPUT;
+            return -1;
+        }
+#endif
+        kb_feature_generation_reset(SML_MODEL_INDEX);
+        if (kb_feature_generation(SML_MODEL_INDEX) == 1){
+            *stage = SML_STAGE_CLASSIFY;
+            return -1;
+        }
+        ret = -2;//features filtered
+        break;
+    case SML_STAGE_CLASSIFY:
+        //feature transform (min max scale) and PME, feature bank bookkeeping stays in the library
+        ret = kb_generate_classification(SML_MODEL_INDEX);
+#endif
+        if (ret >= 0){
+#if SML_CASCADE
+            sml_cascade_second(ret);
+#endif
+            *stage = SML_STAGE_OUTPUT;
+            return -1;
+        }
+        break;
+    case SML_STAGE_OUTPUT:
+        sml_output_results(SML_MODEL_INDEX);
+        break;
+    default:
+        return -1;
+    }
+    *stage = SML_STAGE_DONE;
+    kb_reset_model(0);
+    return ret;
+}
+
+void sml_segment_sample(int16_t sample)
+{
+#if SML_CASCADE
+    sml_cascade_sample(&sml_cascade, sample);
+#else
+    (void)sample;
+#endif
+}
+
+void sml_result(sml_result_t *result)
+{
+    *result = sml_last;
+}
+
+bool sml_cascade_stats(sml_cascade_stats_t *stats)
+{
+#if SML_CASCADE
+    *stats = sml_cascade_count;
+    return true;
+#else
+    (void)stats;
+    return false;
+#endif
+}
+
+bool sml_profile_cycles(uint32_t *family_cycles, uint32_t *classifier_cycles)
+{
+#if SML_PROFILER && SML_FIXED_POINT
+    //one FFT gives every feature and the transform is part of it, so all of it is the HPS family
+    memset(family_cycles, 0, SML_FAMILIES*sizeof(uint32_t));
+    family_cycles[SML_FAMILY_HPS] = sml_fixed_feature_cycles;
+    *classifier_cycles = sml_fixed_classifier_cycles;
+    return true;
+#elif SML_PROFILER
+    uint32_t gen_cycles[MAX_VECTOR_SIZE];
+    int32_t i;
+
+    //the library fills its counters only when the knowledge pack itself is built with SML_PROFILER
+    if (!kb_is_profiling_enabled(SML_MODEL_INDEX)){
+        return false;
+    }
+    memset(gen_cycles, 0, sizeof(gen_cycles));
+    kb_get_feature_gen_cycles(SML_MODEL_INDEX, gen_cycles);
+    memset(family_cycles, 0, SML_FAMILIES*sizeof(uint32_t));
+    for (i = 0; i < SML_GENERATORS; i++){
+        family_cycles[sml_generator_family[i]] += gen_cycles[i];
+    }
+    *classifier_cycles = kb_get_classifier_cycles(SML_MODEL_INDEX);
+    return true;
+#else
+    return false;
+#endif
+}
@@ -2,6 +2,75 @@
 #define __SML_RECOGNITION_RUN_H__
 #include "../mplabml/inc/kb.h"
 
+//window_size of the Windowing segmenter in model.json
+#define SML_SEGMENT_SIZE 1248
+
+//1: sml_segment_run/sml_segment_step take the feature vector from the integer only sml_fixed_features and
+//leave only the PME to the library, 0: the library's float feature generation and transform
+#define SML_FIXED_POINT 1
+
+//knowledge pack model of the full feature generation and PME, the second stage of the cascade
+#define SML_MODEL_INDEX KB_MODEL_TEST_1_RANK_0_INDEX
+
+//1: a rhythm screen (sml_cascade.h) classifies the windows with a clear rhythm, only the others run the
+//features and the PME of SML_MODEL_INDEX, 0: every window runs them. Off until SML_CASCADE_REGULAR and
+//SML_CASCADE_IRREGULAR are tuned on labeled recordings with kp_batch -C
+#define SML_CASCADE 0
+
+#if SML_FIXED_POINT
+#include "sml_fixed_features.h"
+//leading samples of the window SML_STAGE_FEATURES reads, it can run before the rest of the window is in
+#define SML_FEATURE_SPAN SML_FIXED_SPAN
+#endif
+
+//stages of sml_segment_step, in order
+#define SML_STAGE_SEGMENTATION 0
+#define SML_STAGE_FEATURES     1 //HPS, peak HPS and power spectrum of the window (SML_FIXED_POINT: scaled features),
+                                 //SML_CASCADE: the rhythm screen first, a screened window goes on to SML_STAGE_OUTPUT
+#define SML_STAGE_CLASSIFY     2 //min max scale and PME (SML_FIXED_POINT: PME)
+#define SML_STAGE_OUTPUT       3 //result kept for sml_result and model reset
+#define SML_STAGE_DONE         4
+
+//feature generator families, gen_0001/0002 HPS, gen_0004 peak HPS and gen_0006 power spectrum in model.json
+#define SML_FAMILY_HPS         0
+#define SML_FAMILY_PEAK_HPS    1
+#define SML_FAMILY_POWER       2
+#define SML_FAMILIES           3
+
+//classifier of a window result
+#define SML_SOURCE_PME         0 //PME of the built-in model, in the library
+#define SML_SOURCE_BLOB        1 //PME on the patterns of the model blob (sml_blob.h)
+#define SML_SOURCE_SCREEN      2 //rhythm screen of the cascade alone
+
+//last window result, the numbers of the kb_sprint_model_result line, for the caller to send as a record
+typedef struct {
+    uint8_t source;          //SML_SOURCE_*
+    uint8_t pattern;         //PME pattern that fired, 0 for the screen
+    uint16_t influence;      //its influence field, 0 for the screen
+    uint16_t distance;       //its distance to the window, the irregularity per mille for the screen
+    uint16_t features;       //bytes of vector, 0 for the screen
+    const uint8_t *vector;   //scaled feature vector of the window, valid until its next window starts
+} sml_result_t;
+
+//counters of the cascade since the model input was initialized
+typedef struct {
+    uint32_t windows;      //windows classified
+    uint32_t screened;     //of them by the rhythm screen alone
+    uint32_t audits;       //windows the screen decided that also ran the PME
+    uint32_t disagreed;    //audits the PME classified otherwise
+    int32_t irregularity;  //per mille of the last screen, -1 without enough intervals
+    bool last_screened;    //the last result is the screen's, the window has no feature vector
+} sml_cascade_stats_t;
+
 int32_t sml_recognition_run(int16_t *data, int32_t num_sensors, bool initialize);
+int32_t sml_segment_run(int16_t *segment, int32_t size);
+int32_t sml_segment_step(int16_t *segment, int32_t size, int32_t *stage);
+//one model input sample of the segment path to the rhythm screen, whether or not it goes to a window
+void sml_segment_sample(int16_t sample);
+//result of the last window that gave a class
+void sml_result(sml_result_t *result);
+//false without SML_CASCADE
+bool sml_cascade_stats(sml_cascade_stats_t *stats);
+bool sml_profile_cycles(uint32_t *family_cycles, uint32_t *classifier_cycles);
 
 #endif //__SML_RECOGNITION_RUN_H__
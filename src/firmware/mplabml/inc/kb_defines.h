@@ -8,7 +8,7 @@ extern "C"
 #endif
 
 #define SML_DEBUG 1
-#define SML_PROFILER 0
+// SML_PROFILER is set by the profiling build (-DSML_PROFILER=1)
 #ifndef SML_DEBUG
 #define SML_DEBUG 0
 #endif
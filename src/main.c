@@ -30,8 +30,11 @@
 #include "main.h"
 #include "app_oled.h"
 #include "app_ecg.h"
+#include "app_timer.h"
 #include "GraphicLib.h"
 #include "firmware/mplabml/inc/kb.h"
+#include "firmware/application/sml_learn.h"
+#include "firmware/application/sml_blob.h"
 
 #define SYS_CONSOLE_PRINT_BUFFER_SIZE   200
 static char consolePrintBuffer[SYS_CONSOLE_PRINT_BUFFER_SIZE];
@@ -42,28 +45,37 @@ volatile int8_t ADC_ChannelIdx = 0;
 uint8_t Duty = 50;
 int8_t DutyDistance = 2;
 
-volatile uint32_t IntervalTimerCount[MAX_DELAY_TIMER];
-volatile uint32_t IntervalTimerTarget[MAX_DELAY_TIMER];
+APP_TIMER IntervalTimer[MAX_DELAY_TIMER]; // Delays of the main loop and the apps, polled
 float MCP9700_Temp;
 uint8_t VR1_Pos;
 
 void TC4_DelayMS(uint32_t ms, uint8_t idx)
 {
-    IntervalTimerCount[idx] = 1; // Start Delay Counter
-    IntervalTimerTarget[idx] = ms*10; // TC4 in 100us period for DV interval
+    APP_TIMER_Start(&IntervalTimer[idx], ms * APP_TIMER_TICKS_PER_MS);
 }
 
 bool TC4_DelayIsComplete(uint8_t idx)
 {
-    if (IntervalTimerCount[idx] != 0 &&
-        IntervalTimerCount[idx] > IntervalTimerTarget[idx])
-    {
-        // Disable current Interval Timer
-        IntervalTimerCount[idx] = 0;
-        return true;
-    }
+    // Once after the delay, until the next TC4_DelayMS
+    return APP_TIMER_Expired(&IntervalTimer[idx]);
+}
+
+uint32_t TC4_GetTickCount(void)
+{
+    return APP_TIMER_GetTicks();
+}
+
+uint32_t CPU_GetCycles(void)
+{
+    uint32_t Tick, Count;
 
-    return false;
+    // Read SysTick ms counter and down counter without a tick in between
+    do {
+        Tick  = SYSTICK_GetTickCounter();
+        Count = SYSTICK_TimerCounterGet();
+    } while (Tick != SYSTICK_GetTickCounter());
+
+    return (Tick * (SYSTICK_TimerPeriodGet() + 1)) + (SYSTICK_TimerPeriodGet() - Count);
 }
 
 void ADC_Complete(ADC_STATUS status, uintptr_t context)
@@ -87,19 +99,6 @@ void TC3_TimerExpired(TC_TIMER_STATUS status, uintptr_t context)
     }
 }
 
-void TC4_TimerExpired(TC_TIMER_STATUS status, uintptr_t context)
-{
-    int idx;
-
-    for (idx = 0; idx < MAX_DELAY_TIMER; idx++)
-    {
-        if (IntervalTimerCount[idx] != 0)
-        {
-            IntervalTimerCount[idx]++;
-        }
-    }
-}
-
 void myprintf(const char *format, ...)
 {
     size_t len = 0;
@@ -127,13 +126,20 @@ int main(void)
     /* Initialize all modules */
     SYS_Initialize(NULL);
     kb_model_init();
+    // Patterns learned on this device, from the flash store
+    sml_learn_load();
+    // Uploaded model parameters, read in place by the fixed point path
+    sml_blob_init();
     APP_OLED_Initialize();
     APP_ECG_Initialize();
 
     TC3_TimerCallbackRegister(TC3_TimerExpired, (uintptr_t) NULL);
     TC3_TimerStart();
-    TC4_TimerCallbackRegister(TC4_TimerExpired, (uintptr_t) NULL);
-    TC4_TimerStart();
+    // TC4 timer queue, interrupts only at a deadline or a counter overflow
+    APP_TIMER_Initialize();
+
+    // SysTick 1ms, CPU cycle source for CPU_GetCycles()
+    SYSTICK_TimerStart();
     TC4_DelayMS(BREATH_LED_DELAY, DELAY_TIMER_BREATH_LED);
 
     ADC_CallbackRegister(ADC_Complete, (uintptr_t) NULL);
@@ -154,6 +160,8 @@ int main(void)
 
         APP_ECG_Tasks();
 
+        APP_ECG_InferenceTasks();
+
         if (TC3_HasExpired)
         {
             TC3_HasExpired = 0;
@@ -46,18 +46,15 @@ enum {
     DELAY_TIMER_HEARTBEAT_LED,
     DELAY_TIMER_HEARTBEAT_LED_DUTY,
     DELAY_TIMER_SPLASH_WAIT,
-    DELAY_TIMER_GRPAHIC_UPDATE,
     DELAY_TIMER_INFERENCE_INTERVAL,
-    DELAY_TIMER_5_sec_INTERVAL,
     MAX_DELAY_TIMER
 };
 
 #define BREATH_LED_DELAY            50   // The Breath LED PWM dimming interval delay (LED3)
 #define HEARTBEAT_LED_DUTY_DELAY    100  // The Heartbeat LED On to Off interval duty delay (LED1)
 #define SPLASH_WAIT_DELAY           1000 // The delay time after splash screen
-#define GRPAHIC_UPDATE_DELAY        100  // The OLED update interval delay
+#define OLED_FRAME_RATE             10   // The OLED render target Frames per second
 #define INFERENCE_INTERVAL          3 // The Inference Interval time
-#define five_sec_INTERVAL          5000 // The Inference Interval time
 
     // *****************************************************************************
     // *****************************************************************************
@@ -76,6 +73,8 @@ extern uint8_t VR1_Pos;
 void myprintf(const char *format, ...);
 void TC4_DelayMS( uint32_t ms, uint8_t idx );
 bool TC4_DelayIsComplete( uint8_t idx );
+uint32_t TC4_GetTickCount( void );
+uint32_t CPU_GetCycles( void );
     /* Provide C++ Compatibility */
 #ifdef __cplusplus
 }
@@ -0,0 +1,421 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    KP_Host.c
+
+  @Summary
+    Host reference of the knowledge pack pipeline, window in, class out.
+
+  @Description
+    Port of the fixed point FFT (FFTR_512), the three feature generators,
+    min_max_scale and the PME in KNN/L1 mode as libmplabml.a runs them on
+    the target. Every float step is done in single precision in the same
+    order as the library (double only where the library uses double), so the
+    results are bit exact on any IEEE 754 host.
+
+    Like the library, each generator only looks at the first 512 samples of
+    the window. The generators write 120 bank slots but the library allocates
+    69 and min_max_scale reads the bank modulo 69, see README.md.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include "KP_Host.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: File Scope or Global Data                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#define KP_FFT_SIZE   512                 // Real FFT points
+#define KP_FFT_BINS   (KP_FFT_SIZE/2)     // Complex bins
+#define KP_HANN_SHIFT 14                  // Q14 Hanning weights
+#define KP_LINE_SIZE  512                 // Longest recording line read
+
+// sin(2*pi*k/512)*32767 truncated, k = 0..383, the table of FFTR_512
+static const int16_t KP_Sine512[384] = {
+         0,    402,    804,   1206,   1607,   2009,   2410,   2811,   3211,   3611,   4011,   4409,
+      4807,   5205,   5601,   5997,   6392,   6786,   7179,   7571,   7961,   8351,   8739,   9126,
+      9511,   9895,  10278,  10659,  11038,  11416,  11792,  12166,  12539,  12909,  13278,  13645,
+     14009,  14372,  14732,  15090,  15446,  15799,  16150,  16499,  16845,  17189,  17530,  17868,
+     18204,  18537,  18867,  19194,  19519,  19840,  20159,  20474,  20787,  21096,  21402,  21705,
+     22004,  22301,  22594,  22883,  23169,  23452,  23731,  24006,  24278,  24546,  24811,  25072,
+     25329,  25582,  25831,  26077,  26318,  26556,  26789,  27019,  27244,  27466,  27683,  27896,
+     28105,  28309,  28510,  28706,  28897,  29085,  29268,  29446,  29621,  29790,  29955,  30116,
+     30272,  30424,  30571,  30713,  30851,  30984,  31113,  31236,  31356,  31470,  31580,  31684,
+     31785,  31880,  31970,  32056,  32137,  32213,  32284,  32350,  32412,  32468,  32520,  32567,
+     32609,  32646,  32678,  32705,  32727,  32744,  32757,  32764,  32767,  32764,  32757,  32744,
+     32727,  32705,  32678,  32646,  32609,  32567,  32520,  32468,  32412,  32350,  32284,  32213,
+     32137,  32056,  31970,  31880,  31785,  31684,  31580,  31470,  31356,  31236,  31113,  30984,
+     30851,  30713,  30571,  30424,  30272,  30116,  29955,  29790,  29621,  29446,  29268,  29085,
+     28897,  28706,  28510,  28309,  28105,  27896,  27683,  27466,  27244,  27019,  26789,  26556,
+     26318,  26077,  25831,  25582,  25329,  25072,  24811,  24546,  24278,  24006,  23731,  23452,
+     23169,  22883,  22594,  22301,  22004,  21705,  21402,  21096,  20787,  20474,  20159,  19840,
+     19519,  19194,  18867,  18537,  18204,  17868,  17530,  17189,  16845,  16499,  16150,  15799,
+     15446,  15090,  14732,  14372,  14009,  13645,  13278,  12909,  12539,  12166,  11792,  11416,
+     11038,  10659,  10278,   9895,   9511,   9126,   8739,   8351,   7961,   7571,   7179,   6786,
+      6392,   5997,   5601,   5205,   4807,   4409,   4011,   3611,   3211,   2811,   2410,   2009,
+      1607,   1206,    804,    402,      0,   -402,   -804,  -1206,  -1607,  -2009,  -2410,  -2811,
+     -3211,  -3611,  -4011,  -4409,  -4807,  -5205,  -5601,  -5997,  -6392,  -6786,  -7179,  -7571,
+     -7961,  -8351,  -8739,  -9126,  -9511,  -9895, -10278, -10659, -11038, -11416, -11792, -12166,
+    -12539, -12909, -13278, -13645, -14009, -14372, -14732, -15090, -15446, -15799, -16150, -16499,
+    -16845, -17189, -17530, -17868, -18204, -18537, -18867, -19194, -19519, -19840, -20159, -20474,
+    -20787, -21096, -21402, -21705, -22004, -22301, -22594, -22883, -23169, -23452, -23731, -24006,
+    -24278, -24546, -24811, -25072, -25329, -25582, -25831, -26077, -26318, -26556, -26789, -27019,
+    -27244, -27466, -27683, -27896, -28105, -28309, -28510, -28706, -28897, -29085, -29268, -29446,
+    -29621, -29790, -29955, -30116, -30272, -30424, -30571, -30713, -30851, -30984, -31113, -31236,
+    -31356, -31470, -31580, -31684, -31785, -31880, -31970, -32056, -32137, -32213, -32284, -32350,
+    -32412, -32468, -32520, -32567, -32609, -32646, -32678, -32705, -32727, -32744, -32757, -32764
+};
+
+// Hanning weights of the last size, per thread so windows can run in parallel
+static __thread int16_t KP_Hann[KP_FFT_SIZE/2];
+static __thread int KP_HannSize = 0;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+static uint8_t _KP_BitReverse( uint8_t x )
+{
+    x = (uint8_t)( (x>>4)|(x<<4) );
+    x = (uint8_t)( ((x&0xCC)>>2)|((x&0x33)<<2) );
+    return (uint8_t)( ((x&0xAA)>>1)|((x&0x55)<<1) );
+}
+
+// 512 point real FFT in place, 256 complex bins, each stage scaled by 1/2
+static void _KP_FFTR512( int16_t *pData )
+{
+    int16_t *c = pData;
+    int16_t t;
+    int i, j, k, L, s;
+
+    for( i=1 ; i<KP_FFT_BINS-1 ; i++ )
+    {
+        j = _KP_BitReverse( (uint8_t)i );
+        if( j>i )
+        {
+            t = c[2*i];   c[2*i]   = c[2*j];   c[2*j]   = t;
+            t = c[2*i+1]; c[2*i+1] = c[2*j+1]; c[2*j+1] = t;
+        }
+    }
+
+    for( L=1, s=0 ; L<KP_FFT_BINS ; L<<=1, s++ )
+    {
+        for( j=0 ; j<L ; j++ )
+        {
+            int32_t Idx = j<<(8-s);
+            int32_t wr = KP_Sine512[Idx+128];
+            int32_t wi = (int16_t)-KP_Sine512[Idx];
+
+            for( k=j ; k<KP_FFT_BINS ; k+=2*L )
+            {
+                int32_t rh = c[2*(k+L)]>>1, ih = c[2*(k+L)+1]>>1;
+                int32_t r1 = c[2*k]>>1,     i1 = c[2*k+1]>>1;
+                int32_t A  = (wi*ih+1)>>15;
+                int32_t B  = (wr*rh+1)>>15;
+                int32_t ti = ((wr*ih+1)>>15)+((wi*rh+1)>>15);
+
+                c[2*(k+L)]   = (int16_t)( r1+A-B );
+                c[2*(k+L)+1] = (int16_t)( i1-ti );
+                c[2*k+1]     = (int16_t)( ti+i1 );
+                c[2*k]       = (int16_t)( r1+B-A );
+            }
+        }
+    }
+
+    // Split into the spectrum of the real input, bins 0 and 128 stay as they are
+    for( k=1 ; k<KP_FFT_BINS/2 ; k++ )
+    {
+        int32_t nwr = (int16_t)-KP_Sine512[128+k];
+        int32_t wi  = KP_Sine512[256+k];
+        int32_t ar = c[2*k]>>1,   br = c[2*(KP_FFT_BINS-k)]>>1;
+        int32_t ai = c[2*k+1]>>1, nb = (-c[2*(KP_FFT_BINS-k)+1])>>1;
+        int32_t S = ar+br, P = ai+nb;
+        int32_t Q = (int16_t)( ai-nb ), D = (int16_t)( ar-br );
+        int32_t X = (wi*D+1)>>15;
+        int32_t Y = (nwr*Q+1)>>15;
+        int32_t Tim = ((wi*Q+1)>>15)+((nwr*D+1)>>15);
+
+        c[2*k]                      = (int16_t)( S+X-Y );
+        c[2*k+1]                    = (int16_t)( P+Tim );
+        c[2*(KP_FFT_BINS-k)]        = (int16_t)( S-X+Y );
+        c[2*(KP_FFT_BINS-k)+1]      = (int16_t)( Tim-P );
+    }
+}
+
+static void _KP_RemoveMean( int16_t *pData, int n )
+{
+    int32_t Sum = 0;
+    int i;
+
+    for( i=0 ; i<n ; i++ ) Sum += pData[i];
+    Sum /= n;
+    for( i=0 ; i<n ; i++ ) pData[i] = (int16_t)( (uint16_t)pData[i]-(uint16_t)Sum );
+}
+
+static void _KP_Hanning( int16_t *pData, int n )
+{
+    int i;
+
+    if( n!=KP_HannSize )
+    {
+        for( i=0 ; i<n/2 ; i++ )
+        {
+            float Angle = (float)i*6.283185f/(float)n;
+            float w = (float)( 0.5-0.5*cos( (double)Angle ) );
+
+            KP_Hann[i] = (int16_t)(int32_t)( w*16384.0f );
+        }
+        KP_HannSize = n;
+    }
+    for( i=0 ; i<n/2 ; i++ )
+    {
+        pData[i]     = (int16_t)( (pData[i]*KP_Hann[i]+1)>>KP_HANN_SHIFT );
+        pData[n-1-i] = (int16_t)( (pData[n-1-i]*KP_Hann[i]+1)>>KP_HANN_SHIFT );
+    }
+}
+
+static void _KP_AutoScale( int16_t *pData, int n )
+{
+    int32_t Min = 32767, Max = -32768, Peak;
+    float Scale;
+    int i;
+
+    for( i=0 ; i<n ; i++ )
+    {
+        if( pData[i]<Min ) Min = pData[i];
+        if( pData[i]>Max ) Max = pData[i];
+    }
+    if( abs( Min )>abs( Max ) ) Peak = abs( Min );
+    else if( Max==0 ) return;
+    else Peak = abs( Max );
+
+    Scale = 32767.0f/(float)Peak;
+    if( Scale>1.0f )
+    {
+        for( i=0 ; i<n ; i++ ) pData[i] = (int16_t)(int32_t)( (float)pData[i]*Scale );
+    }
+}
+
+// fftr() of the library, RemoveMean / AutoScale as set by fftr_rm_as / fftr_as
+static int16_t *_KP_FFTR( int16_t *pData, int n, bool RemoveMean, bool AutoScale )
+{
+    int n4 = n<KP_FFT_SIZE ? n : KP_FFT_SIZE;
+    int i;
+
+    if( pData==NULL || n<8 ) return NULL;
+    if( RemoveMean ) _KP_RemoveMean( pData, n4 );
+    _KP_Hanning( pData, n4 );
+    if( AutoScale ) _KP_AutoScale( pData, KP_FFT_SIZE );
+    if( n<KP_FFT_SIZE )
+    {
+        for( i=n4 ; i<KP_FFT_SIZE ; i++ ) pData[i] = 0;
+    }
+    _KP_FFTR512( pData );
+    return pData;
+}
+
+// First 512 samples of the window into the FFT buffer (sortedData of the library)
+static int _KP_Load( int16_t *pData, const int16_t *pWindow )
+{
+    int n = KP_WINDOW_SIZE<KP_FFT_SIZE ? KP_WINDOW_SIZE : KP_FFT_SIZE;
+
+    memcpy( pData, pWindow, n*sizeof(int16_t) );
+    return n;
+}
+
+// Magnitude of the 256 bins, in place
+static void _KP_Magnitude( int16_t *pData )
+{
+    int j;
+
+    for( j=0 ; j<KP_FFT_BINS ; j++ )
+    {
+        float Re = (float)pData[2*j];
+        float Im2 = (float)( pData[2*j+1]*pData[2*j+1] );
+
+        pData[j] = (int16_t)(int32_t)sqrt( (double)( Im2+Re*Re ) );
+    }
+}
+
+// Harmonic Product Spectrum, bins 1..50 of the first block
+static int _KP_HPS( int16_t *pData, const int16_t *pWindow, float *pFV )
+{
+    int i, h;
+
+    _KP_Load( pData, pWindow );
+    _KP_FFTR( pData, KP_WINDOW_SIZE, true, true );
+    _KP_Magnitude( pData );
+
+    for( i=1 ; i<KP_HPS_BLOCK ; i++ )
+    {
+        float Product = (float)pData[i];
+
+        for( h=2 ; h<KP_HPS_HARMONICS ; h++ ) Product *= (float)pData[h*i];
+        pFV[i] = Product;
+    }
+    return 2*KP_HPS_BLOCK;
+}
+
+// Peak Harmonic Product Spectrum, integer product, bin and value of the peak
+static int _KP_PeakHPS( int16_t *pData, const int16_t *pWindow, float *pFV )
+{
+    int32_t Peak = 0;
+    int i, h, Bin = 0;
+
+    _KP_Load( pData, pWindow );
+    _KP_FFTR( pData, KP_WINDOW_SIZE, true, true );
+    _KP_Magnitude( pData );
+
+    for( i=1 ; i<KP_HPS_BLOCK ; i++ )
+    {
+        uint32_t Product = (uint32_t)pData[i];
+
+        for( h=2 ; h<KP_HPS_HARMONICS ; h++ ) Product *= (uint32_t)pData[h*i];
+        if( (int32_t)Product>Peak )
+        {
+            Peak = (int32_t)Product;
+            Bin = i;
+        }
+    }
+    pFV[0] = (float)Bin;
+    pFV[1] = (float)Peak;
+    return 2;
+}
+
+// Power Spectrum, Hanning only, sum of sqrt(re^2+im^2) over 256/bins bins
+static int _KP_Power( int16_t *pData, const int16_t *pWindow, float *pFV )
+{
+    int n = _KP_Load( pData, pWindow );
+    int k;
+
+    _KP_FFTR( pData, n, false, false );
+    for( k=0 ; k<KP_FFT_BINS ; k++ )
+    {
+        int32_t Re = pData[2*k], Im = pData[2*k+1];
+
+        pFV[k/(KP_FFT_BINS/KP_POWER_BINS)] += sqrtf( (float)(int32_t)( (uint32_t)(Re*Re)+(uint32_t)(Im*Im) ) );
+    }
+    return KP_POWER_BINS;
+}
+
+static uint8_t _KP_Scale( float x, float Min, float Max )
+{
+    float v = (float)( (double)( (x-Min)*KP_SCALE_MAX )/( (double)( Max-Min )+1e-10 ) );
+
+    if( KP_SCALE_MAX<v ) v = KP_SCALE_MAX;
+    if( v<KP_SCALE_MIN ) v = KP_SCALE_MIN;
+    return (uint8_t)(uint32_t)v;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+int32_t KP_Host_Run( const int16_t *pWindow, KP_HOST_RESULT *pResult )
+{
+    int16_t Data[KP_FFT_SIZE];
+    uint16_t Best = 0xFFFF;
+    int i, p;
+
+    memset( pResult, 0, sizeof(*pResult) );
+
+    _KP_HPS( Data, pWindow, &pResult->Bank[KP_HPS_OFFSET] );
+    _KP_PeakHPS( Data, pWindow, &pResult->Bank[KP_PEAK_OFFSET] );
+    _KP_Power( Data, pWindow, &pResult->Bank[KP_POWER_OFFSET] );
+
+    for( i=0 ; i<KP_FEATURES ; i++ )
+    {
+        pResult->Features[i] = _KP_Scale( pResult->Bank[KP_FeatureIndex[i]%KP_BANK_SIZE],
+                                          KP_FeatureMin[i], KP_FeatureMax[i] );
+    }
+
+    // Nearest pattern by L1 distance, the first one on a tie
+    for( p=0 ; p<KP_PATTERNS ; p++ )
+    {
+        uint16_t Dist = 0;
+
+        for( i=0 ; i<KP_FEATURES ; i++ ) Dist += (uint16_t)abs( pResult->Features[i]-KP_Pattern[p][i] );
+        if( Dist<Best )
+        {
+            Best = Dist;
+            pResult->Pattern = (uint16_t)p;
+        }
+    }
+    pResult->Distance = Best;
+    pResult->Class = KP_PatternCategory[pResult->Pattern];
+    pResult->OutputTensor[0] = (float)pResult->Pattern;
+    pResult->OutputTensor[1] = (float)pResult->Class;
+    pResult->OutputTensor[2] = (float)KP_PatternAIF[pResult->Pattern];
+    pResult->OutputTensor[3] = (float)pResult->Distance;
+
+    return pResult->Class;
+}
+
+// Recording of samples, one per line, first number of a CSV line, other lines
+// skipped. Returns the sample count with *ppSamples to free(), -1 on error.
+int KP_Host_Load( const char *path, int16_t **ppSamples )
+{
+    FILE *pFile = strcmp( path, "-" ) ? fopen( path, "r" ) : stdin;
+    char Line[KP_LINE_SIZE];
+    int16_t *pSamples = NULL, *pGrow;
+    int Count = 0, Size = 0;
+    char *pEnd;
+    long v;
+
+    if( pFile==NULL ) return -1;
+    while( fgets( Line, sizeof(Line), pFile ) )
+    {
+        v = strtol( Line, &pEnd, 10 );
+        if( pEnd==Line ) continue;
+        if( Count==Size )
+        {
+            Size = Size ? Size*2 : 4096;
+            pGrow = realloc( pSamples, Size*sizeof(int16_t) );
+            if( pGrow==NULL )
+            {
+                Count = -1;
+                break;
+            }
+            pSamples = pGrow;
+        }
+        pSamples[Count++] = (int16_t)v;
+    }
+    if( pFile!=stdin ) fclose( pFile );
+    if( Count<0 )
+    {
+        free( pSamples );
+        pSamples = NULL;
+    }
+    *ppSamples = pSamples;
+    return Count;
+}
+
+// Same line as kb_sprint_model_result() prints on the target console
+int KP_Host_Sprint( const KP_HOST_RESULT *pResult, char *pBuf, size_t size )
+{
+    return snprintf( pBuf, size, "{\"ModelNumber\":%d,\"Classification\":%ld,\"OutputSize\":%d,"
+                     "\"OutputTensor\":[%f,%f,%f,%f]}", 0, (long)pResult->Class, KP_OUTPUT_SIZE,
+                     pResult->OutputTensor[0], pResult->OutputTensor[1],
+                     pResult->OutputTensor[2], pResult->OutputTensor[3] );
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    KP_Host.h
+
+  @Summary
+    Host reference of the knowledge pack pipeline, window in, class out.
+
+  @Description
+    Runs the same steps as kb_run_segment() of libmplabml.a on one window of
+    BMD101 samples: Harmonic Product Spectrum, Peak Harmonic Product Spectrum,
+    Power Spectrum, Min Max Scale and the PME classifier. The integer FFT,
+    windowing and float rounding follow the library, so features and class
+    match the target for the same window. KP_Host_Run() can be called from
+    several threads at once.
+ */
+/* ************************************************************************** */
+
+#ifndef _KP_HOST_H    /* Guard against multiple inclusion */
+#define _KP_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "kp_model.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Data Types
+    // *****************************************************************************
+    // *****************************************************************************
+#define KP_OUTPUT_SIZE 4   // PME output tensor: pattern, category, AIF, distance
+
+typedef struct {
+    float    Bank[KP_BANK_WRITTEN];         // Generator outputs
+    uint8_t  Features[KP_FEATURES];         // Scaled feature vector the PME sees
+    uint16_t Pattern;                       // Nearest pattern
+    uint16_t Distance;                      // L1 distance to it
+    int32_t  Class;                         // Category of the nearest pattern
+    float    OutputTensor[KP_OUTPUT_SIZE];
+} KP_HOST_RESULT;
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Interface Functions
+    // *****************************************************************************
+    // *****************************************************************************
+int32_t KP_Host_Run( const int16_t *pWindow, KP_HOST_RESULT *pResult );
+int KP_Host_Sprint( const KP_HOST_RESULT *pResult, char *pBuf, size_t size );
+int KP_Host_Load( const char *path, int16_t **ppSamples );
+
+    /* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _KP_HOST_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,553 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    kp_batch.c
+
+  @Summary
+    Parallel batch run of the knowledge pack reference over a recording set.
+
+  @Description
+    Loads every recording under a directory, cuts them into model windows and
+    classifies the windows with KP_Host.c on a pool of worker threads. Prints
+    the confusion matrix against the labels taken from the recording paths
+    and the windows/s throughput, and writes the per window results.
+
+    kp_batch [-j threads] [-s hop] [-o results.csv] [-S] [-C] [-T] dir
+      -j : worker threads (default all online cores)
+      -s : samples between window starts (default one window)
+      -o : write file,window,start,label,class,pattern,distance per window,
+           and the irregularity with -C
+      -S : scaling run, classify all windows with 1, 2, 4 .. threads
+      -C : cascade, the rhythm screen of sml_cascade.c classifies first and
+           the PME only the windows it escalates. A recording is replayed as
+           the target monitors it from 'k', the screen sees the samples the
+           target's screen sees
+      -T : with -C, sweep SML_CASCADE_REGULAR/IRREGULAR on the labeled windows
+ */
+/* ************************************************************************** */
+
+#define _XOPEN_SOURCE 700   // nftw()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+#include <ftw.h>
+#include <pthread.h>
+#include "KP_Host.h"
+#include "sml_cascade.h"
+#include "sml_fixed_features.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: File Scope or Global Data                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#define HOST_CHUNK      16    // Windows a worker takes at a time
+#define HOST_MAX_THREADS 256
+#define HOST_NO_LABEL   (-1)
+#define HOST_IRR_MAX    2000  // -T: irregularity bins, per mille, higher ones in the last
+
+typedef struct {
+    char    *Path;
+    int16_t *pSamples;
+    int      Count;         // Samples, -1 when the file could not be read
+    int      Label;         // Class index from the path, HOST_NO_LABEL if none
+    int      Window;        // First window of the recording
+    int      Windows;
+} HOST_RECORD;
+
+typedef struct {
+    int32_t  Record;
+    int32_t  Start;         // First sample of the window
+} HOST_WINDOW;
+
+typedef struct {
+    int16_t  Class;
+    uint16_t Pattern;
+    uint16_t Distance;
+    int16_t  Screen;        // -C: class of the rhythm screen, -1 escalated to the PME
+    int32_t  Irregularity;  // -C: per mille of the screen, -1 escalated whatever the thresholds
+} HOST_RESULT;
+
+const char *Host_Root = NULL;
+HOST_RECORD *Host_Records = NULL;
+int Host_RecordCount = 0, Host_RecordSize = 0;
+HOST_WINDOW *Host_Windows = NULL;
+HOST_RESULT *Host_Results = NULL;
+int Host_WindowCount = 0;
+int Host_Hop = KP_WINDOW_SIZE;
+int Host_Next = 0;          // Next record / window to hand out, taken atomically
+int Host_Cascade = 0;
+int Host_Tune = 0;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+static double _Host_Now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec+ts.tv_nsec*1e-9;
+}
+
+// Class whose name is a directory of the path below the root, or the start
+// of the file name up to '_', '-' or '.'
+static int _Host_Label( const char *path )
+{
+    const char *p = path+strlen( Host_Root );
+    size_t Len;
+    int i;
+
+    while( *p )
+    {
+        while( *p=='/' ) p++;
+        Len = strcspn( p, "/" );
+        if( p[Len]=='\0' ) Len = strcspn( p, "_-." );
+        for( i=0 ; i<KP_CLASSES ; i++ )
+        {
+            if( strlen( KP_ClassName[i] )==Len && strncasecmp( p, KP_ClassName[i], Len )==0 ) return i;
+        }
+        p += strcspn( p, "/" );
+    }
+    return HOST_NO_LABEL;
+}
+
+static int _Host_AddFile( const char *path, const struct stat *pStat, int type, struct FTW *pFtw )
+{
+    HOST_RECORD *pGrow;
+
+    (void)pStat;
+    if( type!=FTW_F || path[pFtw->base]=='.' ) return 0;
+    if( Host_RecordCount==Host_RecordSize )
+    {
+        Host_RecordSize = Host_RecordSize ? Host_RecordSize*2 : 256;
+        pGrow = realloc( Host_Records, Host_RecordSize*sizeof(HOST_RECORD) );
+        if( pGrow==NULL ) return 1;
+        Host_Records = pGrow;
+    }
+    memset( &Host_Records[Host_RecordCount], 0, sizeof(HOST_RECORD) );
+    Host_Records[Host_RecordCount].Path = strdup( path );
+    Host_Records[Host_RecordCount].Label = _Host_Label( path );
+    Host_RecordCount++;
+    return 0;
+}
+
+static int _Host_ComparePath( const void *a, const void *b )
+{
+    return strcmp( ((const HOST_RECORD *)a)->Path, ((const HOST_RECORD *)b)->Path );
+}
+
+static void *_Host_LoadJob( void *pArg )
+{
+    int r;
+
+    (void)pArg;
+    while( ( r = __atomic_fetch_add( &Host_Next, 1, __ATOMIC_RELAXED ) ) < Host_RecordCount )
+    {
+        Host_Records[r].Count = KP_Host_Load( Host_Records[r].Path, &Host_Records[r].pSamples );
+    }
+    return NULL;
+}
+
+// Sample count at which the target screens a window starting at Start. With SML_EARLY_ENABLE the
+// features stage, which screens first, runs once SML_FIXED_SPAN samples of the window are in; a window
+// after the first starts with the overlap of the one before and runs at once when that is longer.
+static int _Host_ScreenAt( int Start )
+{
+    int Overlap = KP_WINDOW_SIZE-Host_Hop;
+
+    return Start + ( Start>0 && Overlap>SML_FIXED_SPAN ? Overlap : SML_FIXED_SPAN );
+}
+
+// Rhythm screen of each window of a recording, fed sample by sample as on the target: from the start of
+// the recording with overlapping windows (SML_CONTINUOUS_ENABLE), from the start of each window otherwise,
+// where every result ends the monitoring and 'k' starts it again
+static void *_Host_ScreenJob( void *pArg )
+{
+    sml_cascade_t Cascade;
+    const HOST_RECORD *pRecord;
+    HOST_RESULT *pResult;
+    int r, w, n, At;
+
+    (void)pArg;
+    while( ( r = __atomic_fetch_add( &Host_Next, 1, __ATOMIC_RELAXED ) ) < Host_RecordCount )
+    {
+        pRecord = &Host_Records[r];
+        sml_cascade_init( &Cascade );
+        n = 0;
+        for( w=pRecord->Window ; w<pRecord->Window+pRecord->Windows ; w++ )
+        {
+            if( Host_Hop>=KP_WINDOW_SIZE )
+            {
+                sml_cascade_init( &Cascade );
+                n = Host_Windows[w].Start;
+            }
+            for( At=_Host_ScreenAt( Host_Windows[w].Start ) ; n<At ; n++ ) sml_cascade_sample( &Cascade, pRecord->pSamples[n] );
+            pResult = &Host_Results[w];
+            pResult->Screen = (int16_t)sml_cascade_screen( &Cascade, &pResult->Irregularity );
+        }
+    }
+    return NULL;
+}
+
+static void *_Host_ClassifyJob( void *pArg )
+{
+    KP_HOST_RESULT Result;
+    const HOST_WINDOW *pWindow;
+    int w, End;
+
+    (void)pArg;
+    while( ( w = __atomic_fetch_add( &Host_Next, HOST_CHUNK, __ATOMIC_RELAXED ) ) < Host_WindowCount )
+    {
+        End = w+HOST_CHUNK<Host_WindowCount ? w+HOST_CHUNK : Host_WindowCount;
+        for( ; w<End ; w++ )
+        {
+            pWindow = &Host_Windows[w];
+            KP_Host_Run( &Host_Records[pWindow->Record].pSamples[pWindow->Start], &Result );
+            Host_Results[w].Class    = (int16_t)Result.Class;
+            Host_Results[w].Pattern  = Result.Pattern;
+            Host_Results[w].Distance = Result.Distance;
+        }
+    }
+    return NULL;
+}
+
+// Run job on threads workers until the shared counter runs out, seconds taken
+static double _Host_Parallel( int threads, void *(*job)( void * ) )
+{
+    pthread_t Thread[HOST_MAX_THREADS];
+    double Start = _Host_Now();
+    int i, Started;
+
+    Host_Next = 0;
+    for( Started=0 ; Started<threads ; Started++ )
+    {
+        if( pthread_create( &Thread[Started], NULL, job, NULL )!=0 ) break;
+    }
+    if( Started==0 ) job( NULL );
+    for( i=0 ; i<Started ; i++ ) pthread_join( Thread[i], NULL );
+    return _Host_Now()-Start;
+}
+
+static int _Host_Segment( void )
+{
+    int r, w, Start;
+
+    for( r=0 ; r<Host_RecordCount ; r++ )
+    {
+        for( Start=0 ; Start+KP_WINDOW_SIZE<=Host_Records[r].Count ; Start+=Host_Hop ) Host_WindowCount++;
+    }
+    Host_Windows = malloc( ( Host_WindowCount ? Host_WindowCount : 1 )*sizeof(HOST_WINDOW) );
+    Host_Results = calloc( Host_WindowCount ? Host_WindowCount : 1, sizeof(HOST_RESULT) );
+    if( Host_Windows==NULL || Host_Results==NULL ) return -1;
+
+    Host_WindowCount = 0;
+    for( r=0 ; r<Host_RecordCount ; r++ )
+    {
+        Host_Records[r].Window = Host_WindowCount;
+        for( Start=0 ; Start+KP_WINDOW_SIZE<=Host_Records[r].Count ; Start+=Host_Hop )
+        {
+            Host_Windows[Host_WindowCount].Record = r;
+            Host_Windows[Host_WindowCount].Start  = Start;
+            Host_WindowCount++;
+        }
+        Host_Records[r].Windows = Host_WindowCount-Host_Records[r].Window;
+    }
+    for( w=0 ; w<Host_WindowCount ; w++ )
+    {
+        Host_Results[w].Screen = -1;
+        Host_Results[w].Irregularity = -1;
+    }
+    return Host_WindowCount;
+}
+
+static int _Host_WriteResults( const char *path )
+{
+    FILE *pFile = fopen( path, "w" );
+    const HOST_RECORD *pRecord;
+    int w, Window = 0;
+
+    if( pFile==NULL ) return -1;
+    fprintf( pFile, "file,window,start,label,class,pattern,distance%s\n", Host_Cascade ? ",irregularity" : "" );
+    for( w=0 ; w<Host_WindowCount ; w++ )
+    {
+        pRecord = &Host_Records[Host_Windows[w].Record];
+        Window = ( w>0 && Host_Windows[w-1].Record==Host_Windows[w].Record ) ? Window+1 : 0;
+        fprintf( pFile, "%s,%d,%d,%s,%s,%u,%u", pRecord->Path, Window, Host_Windows[w].Start,
+                 pRecord->Label==HOST_NO_LABEL ? "" : KP_ClassName[pRecord->Label],
+                 KP_ClassName[Host_Results[w].Screen>=0 ? Host_Results[w].Screen : Host_Results[w].Class], Host_Results[w].Pattern, Host_Results[w].Distance );
+        if( Host_Cascade ) fprintf( pFile, ",%d", (int)Host_Results[w].Irregularity );
+        fprintf( pFile, "\n" );
+    }
+    fclose( pFile );
+    return 0;
+}
+
+static void _Host_Confusion( void )
+{
+    int Matrix[KP_CLASSES][KP_CLASSES];
+    int Predicted[KP_CLASSES];
+    int Labeled = 0, Correct = 0, Screened = 0, Differ = 0;
+    int w, l, c, Label, Class;
+
+    memset( Matrix, 0, sizeof(Matrix) );
+    memset( Predicted, 0, sizeof(Predicted) );
+    for( w=0 ; w<Host_WindowCount ; w++ )
+    {
+        Label = Host_Records[Host_Windows[w].Record].Label;
+        Class = Host_Results[w].Class;
+        if( Host_Results[w].Screen>=0 )
+        {
+            // The PME ran anyway, to count how often the screen decides otherwise
+            Screened++;
+            if( Host_Results[w].Screen!=Class ) Differ++;
+            Class = Host_Results[w].Screen;
+        }
+        Predicted[Class]++;
+        if( Label==HOST_NO_LABEL ) continue;
+        Matrix[Label][Class]++;
+        Labeled++;
+        if( Label==Class ) Correct++;
+    }
+
+    if( Host_Cascade )
+    {
+        printf( "Cascade: %d of %d windows by rhythm (%.1f%%), %d of them classified otherwise by the PME\n",
+                Screened, Host_WindowCount, 100.0*Screened/Host_WindowCount, Differ );
+    }
+
+    printf( "Classes of %d windows:", Host_WindowCount );
+    for( c=0 ; c<KP_CLASSES ; c++ ) printf( " %s %d", KP_ClassName[c], Predicted[c] );
+    printf( "\n" );
+    if( Labeled==0 )
+    {
+        printf( "No window with a label, no confusion matrix\n" );
+        return;
+    }
+
+    printf( "Confusion matrix (rows label, columns class)\n%-10s", "" );
+    for( c=0 ; c<KP_CLASSES ; c++ ) printf( " %9s", KP_ClassName[c] );
+    printf( " %9s\n", "recall" );
+    for( l=0 ; l<KP_CLASSES ; l++ )
+    {
+        int Row = 0;
+
+        for( c=0 ; c<KP_CLASSES ; c++ ) Row += Matrix[l][c];
+        if( Row==0 ) continue;
+        printf( "%-10s", KP_ClassName[l] );
+        for( c=0 ; c<KP_CLASSES ; c++ ) printf( " %9d", Matrix[l][c] );
+        printf( " %8.1f%%\n", 100.0*Matrix[l][l]/Row );
+    }
+    printf( "Accuracy %.1f%% of %d labeled windows, %d without label\n",
+            100.0*Correct/Labeled, Labeled, Host_WindowCount-Labeled );
+}
+
+// Thresholds that screen the most windows and keep the AFib recall and the accuracy of the PME alone.
+// A window below REGULAR+1 is Normal, from IRREGULAR on AFib, in between or without an irregularity
+// it keeps the class of the PME. The audits of SML_CASCADE_AUDIT are left out.
+static void _Host_TuneScreen( void )
+{
+    static int Total[KP_CLASSES][HOST_IRR_MAX+2], Right[KP_CLASSES][HOST_IRR_MAX+2], All[HOST_IRR_MAX+2];
+    int Labeled = 0, AFibs = 0, PmeRight = 0, PmeAFib = 0;
+    int BestScreened = -1, BestRight = 0, BestAFib = 0, BestRegular = 0, BestIrregular = 0;
+    int w, l, b, Regular, Irregular, Label, Screened, Correct, AFib;
+
+    // Prefix sums over the irregularity, bin 0 for the windows always escalated
+    for( w=0 ; w<Host_WindowCount ; w++ )
+    {
+        Label = Host_Records[Host_Windows[w].Record].Label;
+        b = Host_Results[w].Irregularity<0 ? 0 : 1+( Host_Results[w].Irregularity<HOST_IRR_MAX ? Host_Results[w].Irregularity : HOST_IRR_MAX );
+        All[b]++;
+        if( Label==HOST_NO_LABEL ) continue;
+        Total[Label][b]++;
+        if( Host_Results[w].Class==Label ) Right[Label][b]++;
+    }
+    for( b=1 ; b<HOST_IRR_MAX+2 ; b++ )
+    {
+        All[b] += All[b-1];
+        for( l=0 ; l<KP_CLASSES ; l++ )
+        {
+            Total[l][b] += Total[l][b-1];
+            Right[l][b] += Right[l][b-1];
+        }
+    }
+    for( l=0 ; l<KP_CLASSES ; l++ )
+    {
+        Labeled  += Total[l][HOST_IRR_MAX+1];
+        PmeRight += Right[l][HOST_IRR_MAX+1];
+    }
+    AFibs   = Total[SML_CASCADE_AFIB][HOST_IRR_MAX+1];
+    PmeAFib = Right[SML_CASCADE_AFIB][HOST_IRR_MAX+1];
+    if( AFibs==0 )
+    {
+        printf( "Tune: no AFib labeled window, thresholds not tuned\n" );
+        return;
+    }
+
+    // Bins 1+Regular and 1+Irregular, the screen decides 1..1+Regular and 1+Irregular..HOST_IRR_MAX+1
+    for( Regular=-1 ; Regular<HOST_IRR_MAX ; Regular++ )
+    {
+        for( Irregular=Regular+1 ; Irregular<=HOST_IRR_MAX+1 ; Irregular++ )
+        {
+            int Lo = 1+Regular, Hi = Irregular;  // Escalated bins Lo+1..Hi, IRREGULAR past HOST_IRR_MAX screens no AFib
+
+            Screened = ( All[Lo]-All[0] ) + ( Irregular<=HOST_IRR_MAX ? All[HOST_IRR_MAX+1]-All[Hi] : 0 );
+            AFib = ( Irregular<=HOST_IRR_MAX ? Total[SML_CASCADE_AFIB][HOST_IRR_MAX+1]-Total[SML_CASCADE_AFIB][Hi] : 0 ) +
+                   Right[SML_CASCADE_AFIB][0] + Right[SML_CASCADE_AFIB][Hi]-Right[SML_CASCADE_AFIB][Lo];
+            if( AFib < PmeAFib || Screened < BestScreened ) continue;
+
+            Correct = 0;
+            for( l=0 ; l<KP_CLASSES ; l++ )
+            {
+                Correct += Right[l][0] + Right[l][Hi]-Right[l][Lo];
+                if( l==SML_CASCADE_NORMAL ) Correct += Total[l][Lo]-Total[l][0];
+                if( l==SML_CASCADE_AFIB && Irregular<=HOST_IRR_MAX ) Correct += Total[l][HOST_IRR_MAX+1]-Total[l][Hi];
+            }
+            if( Correct < PmeRight || ( Screened==BestScreened && Correct<=BestRight ) ) continue;
+            BestScreened = Screened;
+            BestRight = Correct;
+            BestAFib = AFib;
+            BestRegular = Regular;
+            BestIrregular = Irregular;
+        }
+    }
+
+    printf( "Tune on %d labeled windows, PME alone: AFib recall %.1f%%, accuracy %.1f%%\n",
+            Labeled, 100.0*PmeAFib/AFibs, 100.0*PmeRight/Labeled );
+    if( BestScreened<=0 )
+    {
+        printf( "Tune: no thresholds screen a window without losing AFib recall or accuracy, leave SML_CASCADE 0\n" );
+        return;
+    }
+    printf( "Tune: SML_CASCADE_REGULAR %d, SML_CASCADE_IRREGULAR %d%s: %d of %d windows by rhythm (%.1f%%), "
+            "AFib recall %.1f%%, accuracy %.1f%%\n",
+            BestRegular, BestIrregular<=HOST_IRR_MAX ? BestIrregular : INT16_MAX,
+            BestRegular<0 ? " (no Normal)" : BestIrregular>HOST_IRR_MAX ? " (no AFib)" : "",
+            BestScreened, Host_WindowCount, 100.0*BestScreened/Host_WindowCount,
+            100.0*BestAFib/AFibs, 100.0*BestRight/Labeled );
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main Entry Point
+// *****************************************************************************
+// *****************************************************************************
+int main( int argc, char *argv[] )
+{
+    const char *pOut = NULL;
+    int Threads = (int)sysconf( _SC_NPROCESSORS_ONLN );
+    int Scaling = 0;
+    long Samples = 0;
+    int Opt, r, Failed = 0;
+    double Load, Seconds, Base = 0.0;
+
+    while( ( Opt = getopt( argc, argv, "j:s:o:SCT" ) )!=-1 )
+    {
+        switch( Opt )
+        {
+            case 'j': Threads  = atoi( optarg ); break;
+            case 's': Host_Hop = atoi( optarg ); break;
+            case 'o': pOut     = optarg; break;
+            case 'S': Scaling  = 1; break;
+            case 'C': Host_Cascade = 1; break;
+            case 'T': Host_Tune = 1; break;
+            default:
+                fprintf( stderr, "usage: %s [-j threads] [-s hop] [-o results.csv] [-S] [-C] [-T] dir\n", argv[0] );
+                return 2;
+        }
+    }
+    if( optind>=argc || Host_Hop<=0 )
+    {
+        fprintf( stderr, "usage: %s [-j threads] [-s hop] [-o results.csv] [-S] [-C] [-T] dir\n", argv[0] );
+        return 2;
+    }
+    if( Threads<1 ) Threads = 1;
+    if( Threads>HOST_MAX_THREADS ) Threads = HOST_MAX_THREADS;
+
+    Host_Root = argv[optind];
+    if( nftw( Host_Root, _Host_AddFile, 32, FTW_PHYS )!=0 )
+    {
+        perror( Host_Root );
+        return 2;
+    }
+    qsort( Host_Records, Host_RecordCount, sizeof(HOST_RECORD), _Host_ComparePath );
+
+    Load = _Host_Parallel( Threads, _Host_LoadJob );
+    for( r=0 ; r<Host_RecordCount ; r++ )
+    {
+        if( Host_Records[r].Count<0 )
+        {
+            fprintf( stderr, "%s: not readable, skipped\n", Host_Records[r].Path );
+            Failed++;
+        }
+        else if( Host_Records[r].Count<KP_WINDOW_SIZE )
+        {
+            fprintf( stderr, "%s: %d samples, shorter than a window\n", Host_Records[r].Path, Host_Records[r].Count );
+        }
+        else Samples += Host_Records[r].Count;
+    }
+    if( _Host_Segment()<0 )
+    {
+        fprintf( stderr, "out of memory for %d windows\n", Host_WindowCount );
+        return 2;
+    }
+    printf( "%d recordings, %ld samples, %d windows of %d (hop %d), loaded in %.2f s\n",
+            Host_RecordCount-Failed, Samples, Host_WindowCount, KP_WINDOW_SIZE, Host_Hop, Load );
+    if( Host_WindowCount==0 ) return 2;
+
+    if( Scaling )
+    {
+        for( r=1 ; ; r = r*2<Threads ? r*2 : Threads )
+        {
+            Seconds = _Host_Parallel( r, _Host_ClassifyJob );
+            if( r==1 ) Base = Seconds;
+            printf( "%3d threads : %10.0f windows/s, speedup %5.2f, efficiency %5.1f%%\n",
+                    r, Host_WindowCount/Seconds, Base/Seconds, 100.0*Base/Seconds/r );
+            if( r==Threads ) break;
+        }
+    }
+    else
+    {
+        Seconds = _Host_Parallel( Threads, _Host_ClassifyJob );
+        printf( "Classified in %.2f s on %d threads: %.0f windows/s\n", Seconds, Threads, Host_WindowCount/Seconds );
+    }
+
+    if( Host_Cascade )
+    {
+        Seconds = _Host_Parallel( Threads, _Host_ScreenJob );
+        printf( "Screened in %.2f s, each window at sample %d of the window (%d after the first)\n",
+                Seconds, _Host_ScreenAt( 0 ), _Host_ScreenAt( Host_Hop )-Host_Hop );
+    }
+
+    _Host_Confusion();
+    if( Host_Cascade && Host_Tune ) _Host_TuneScreen();
+    if( pOut && _Host_WriteResults( pOut )<0 )
+    {
+        perror( pOut );
+        return 2;
+    }
+
+    for( r=0 ; r<Host_RecordCount ; r++ )
+    {
+        free( Host_Records[r].Path );
+        free( Host_Records[r].pSamples );
+    }
+    free( Host_Records );
+    free( Host_Windows );
+    free( Host_Results );
+    return 0;
+}
+
+/* *****************************************************************************
+ End of File
+ */
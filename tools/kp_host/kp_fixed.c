@@ -0,0 +1,296 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    kp_fixed.c
+
+  @Summary
+    Host check of the target's fixed point feature path.
+
+  @Description
+    Runs sml_fixed_features() of src/firmware/application on every window of
+    a recording, next to KP_Host_Run() (the float steps of libmplabml.a) and
+    a double precision reference of the same HPS features without any fixed
+    point step. Prints the feature and class mismatches of the fixed point
+    path against the library, the error of both against the double reference
+    and the time per window of the three.
+
+    Build with -DSML_FIXED_ALL_BINS=1 to time the path without the bin
+    selection of sml_fixed_model.h.
+
+    kp_fixed [-s hop] [-n iterations] samples
+      -s : samples between window starts (default one window)
+      -n : timing iterations of each path on the first window (default 1000)
+ */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+#include "KP_Host.h"
+#include "sml_fixed_features.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: File Scope or Global Data                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#define HOST_FFT_SIZE 512
+
+#if SML_FIXED_FEATURES!=KP_FEATURES || SML_FIXED_WINDOW!=KP_WINDOW_SIZE
+#error "sml_fixed_model.h and kp_model.h are from different models, run kp_model.py"
+#endif
+
+int16_t *Host_Samples = NULL;
+int16_t Host_Work[SML_FIXED_SPAN]; // FFT work area of sml_fixed_features
+int Host_Count = 0;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+static double _Host_Now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec*1e9+ts.tv_nsec;
+}
+
+// In place radix-2 complex FFT, no scaling
+static void _Host_FFT( double *pRe, double *pIm, int n )
+{
+    double t;
+    int i, j, k, L;
+
+    for( i=1, j=0 ; i<n ; i++ )
+    {
+        for( k=n>>1 ; j&k ; k>>=1 ) j ^= k;
+        j ^= k;
+        if( i<j )
+        {
+            t = pRe[i]; pRe[i] = pRe[j]; pRe[j] = t;
+            t = pIm[i]; pIm[i] = pIm[j]; pIm[j] = t;
+        }
+    }
+    for( L=1 ; L<n ; L<<=1 )
+    {
+        for( j=0 ; j<L ; j++ )
+        {
+            double wr = cos( M_PI*j/L ), wi = -sin( M_PI*j/L );
+
+            for( k=j ; k<n ; k+=2*L )
+            {
+                double tr = wr*pRe[k+L]-wi*pIm[k+L];
+                double ti = wr*pIm[k+L]+wi*pRe[k+L];
+
+                pRe[k+L] = pRe[k]-tr; pIm[k+L] = pIm[k]-ti;
+                pRe[k]  += tr;        pIm[k]   += ti;
+            }
+        }
+    }
+}
+
+// HPS features in double: mean removal, the library's Hanning weights,
+// autoscale without truncation, FFT scaled by 1/256 like FFTR_512
+static void _Host_Reference( const int16_t *pWindow, double *pProduct, uint8_t *pFeatures )
+{
+    double Re[HOST_FFT_SIZE], Im[HOST_FFT_SIZE], Mag[HOST_FFT_SIZE/2];
+    double Mean = 0.0, Peak = 0.0, v;
+    int i, h;
+
+    for( i=0 ; i<HOST_FFT_SIZE ; i++ ) Mean += pWindow[i];
+    Mean /= HOST_FFT_SIZE;
+    for( i=0 ; i<HOST_FFT_SIZE/2 ; i++ )
+    {
+        double w = 0.5-0.5*cos( 2.0*M_PI*i/HOST_FFT_SIZE );
+
+        Re[i] = ( pWindow[i]-Mean )*w;
+        Re[HOST_FFT_SIZE-1-i] = ( pWindow[HOST_FFT_SIZE-1-i]-Mean )*w;
+    }
+    for( i=0 ; i<HOST_FFT_SIZE ; i++ )
+    {
+        Im[i] = 0.0;
+        if( fabs( Re[i] )>Peak ) Peak = fabs( Re[i] );
+    }
+    for( i=0 ; i<HOST_FFT_SIZE ; i++ )
+    {
+        if( Peak>0.0 && Peak<32767.0 ) Re[i] *= 32767.0/Peak;
+    }
+    _Host_FFT( Re, Im, HOST_FFT_SIZE );
+    for( i=0 ; i<HOST_FFT_SIZE/2 ; i++ ) Mag[i] = hypot( Re[i], Im[i] )/( HOST_FFT_SIZE/2 );
+
+    for( i=0 ; i<KP_FEATURES ; i++ )
+    {
+        pProduct[i] = 0.0;
+        if( sml_fixed_bin[i] )
+        {
+            pProduct[i] = Mag[sml_fixed_bin[i]];
+            for( h=2 ; h<KP_HPS_HARMONICS ; h++ ) pProduct[i] *= Mag[h*sml_fixed_bin[i]];
+        }
+        v = floor( pProduct[i]*255.0/KP_FeatureMax[i] );
+        pFeatures[i] = (uint8_t)( v>255.0 ? 255.0 : v );
+    }
+}
+
+// Class of the nearest pattern, the first one on a tie
+static int _Host_Classify( const uint8_t *pFeatures )
+{
+    int Best = 0x7FFFFFFF, Class = 0;
+    int i, p, Dist;
+
+    for( p=0 ; p<KP_PATTERNS ; p++ )
+    {
+        for( i=0, Dist=0 ; i<KP_FEATURES ; i++ ) Dist += abs( pFeatures[i]-KP_Pattern[p][i] );
+        if( Dist<Best )
+        {
+            Best = Dist;
+            Class = KP_PatternCategory[p];
+        }
+    }
+    return Class;
+}
+
+static int _Host_CompareDouble( const void *a, const void *b )
+{
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return x<y ? -1 : x>y;
+}
+
+static void _Host_Benchmark( const int16_t *pWindow, int iterations )
+{
+    KP_HOST_RESULT Result;
+    uint8_t Features[KP_FEATURES];
+    double Product[KP_FEATURES];
+    double Start;
+    int i;
+
+    Start = _Host_Now();
+    for( i=0 ; i<iterations ; i++ ) KP_Host_Run( pWindow, &Result );
+    printf( "KP_Host_Run (library, 3 FFTs) : %9.1f ns\n", ( _Host_Now()-Start )/iterations );
+    Start = _Host_Now();
+    for( i=0 ; i<iterations ; i++ ) sml_fixed_features( pWindow, Host_Work, Features );
+    printf( "sml_fixed_features            : %9.1f ns\n", ( _Host_Now()-Start )/iterations );
+    Start = _Host_Now();
+    for( i=0 ; i<iterations ; i++ ) _Host_Reference( pWindow, Product, Features );
+    printf( "Double reference              : %9.1f ns\n", ( _Host_Now()-Start )/iterations );
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main Entry Point
+// *****************************************************************************
+// *****************************************************************************
+int main( int argc, char *argv[] )
+{
+    KP_HOST_RESULT Result;
+    uint8_t Fixed[KP_FEATURES], Reference[KP_FEATURES];
+    double Product[KP_FEATURES];
+    double *pError = NULL;
+    int Hop = KP_WINDOW_SIZE, Iterations = 1000;
+    int Windows = 0, FeatureMismatch = 0, WindowMismatch = 0, ClassMismatch = 0, ReferenceClass = 0;
+    int Errors = 0, ErrorSize = 0, MaxDiff = 0, Diff;
+    long DiffSum = 0;
+    int Opt, Start, i;
+    bool Mismatch;
+
+    while( ( Opt = getopt( argc, argv, "s:n:" ) )!=-1 )
+    {
+        switch( Opt )
+        {
+            case 's': Hop        = atoi( optarg ); break;
+            case 'n': Iterations = atoi( optarg ); break;
+            default:
+                fprintf( stderr, "usage: %s [-s hop] [-n iterations] samples\n", argv[0] );
+                return 2;
+        }
+    }
+    if( optind>=argc || Hop<=0 )
+    {
+        fprintf( stderr, "usage: %s [-s hop] [-n iterations] samples\n", argv[0] );
+        return 2;
+    }
+    Host_Count = KP_Host_Load( argv[optind], &Host_Samples );
+    if( Host_Count<0 )
+    {
+        perror( argv[optind] );
+        return 2;
+    }
+    if( Host_Count<KP_WINDOW_SIZE )
+    {
+        fprintf( stderr, "%s: %d samples, a window is %d\n", argv[optind], Host_Count, KP_WINDOW_SIZE );
+        return 2;
+    }
+
+    for( Start=0 ; Start+KP_WINDOW_SIZE<=Host_Count ; Start+=Hop )
+    {
+        KP_Host_Run( &Host_Samples[Start], &Result );
+        sml_fixed_features( &Host_Samples[Start], Host_Work, Fixed );
+        _Host_Reference( &Host_Samples[Start], Product, Reference );
+        Windows++;
+
+        for( i=0, Mismatch=false ; i<KP_FEATURES ; i++ )
+        {
+            if( Fixed[i]!=Result.Features[i] )
+            {
+                if( FeatureMismatch<10 ) printf( "Window %d feature %d: fixed %u, library %u\n",
+                                                 Windows, i, Fixed[i], Result.Features[i] );
+                FeatureMismatch++;
+                Mismatch = true;
+            }
+            Diff = abs( Fixed[i]-Reference[i] );
+            DiffSum += Diff;
+            if( Diff>MaxDiff ) MaxDiff = Diff;
+
+            // Relative HPS error of the used bins, the product the library and fixed path share
+            if( sml_fixed_bin[i] && Product[i]>0.0 && Result.Bank[sml_fixed_bin[i]]>0.0f )
+            {
+                if( Errors==ErrorSize )
+                {
+                    ErrorSize = ErrorSize ? ErrorSize*2 : 4096;
+                    pError = realloc( pError, ErrorSize*sizeof(double) );
+                    if( pError==NULL ) return 2;
+                }
+                pError[Errors++] = fabs( Result.Bank[sml_fixed_bin[i]]/Product[i]-1.0 );
+            }
+        }
+        if( Mismatch ) WindowMismatch++;
+        if( _Host_Classify( Fixed )!=Result.Class ) ClassMismatch++;
+        if( _Host_Classify( Reference )!=Result.Class ) ReferenceClass++;
+    }
+
+#if SML_FIXED_ALL_BINS
+    printf( "%d windows, fixed point path with all 127 split pairs and 256 magnitudes\n", Windows );
+#else
+    printf( "%d windows, fixed point path with %d of 127 split pairs and %d of 256 magnitudes\n",
+            Windows, SML_FIXED_SPLITS, SML_FIXED_MAGNITUDES );
+#endif
+    printf( "Fixed point vs library : %d feature mismatches in %d windows, %d class mismatches\n",
+            FeatureMismatch, WindowMismatch, ClassMismatch );
+    printf( "Fixed point vs double  : feature error mean %.3f max %d, class differs in %d windows\n",
+            (double)DiffSum/( Windows*KP_FEATURES ), MaxDiff, ReferenceClass );
+    if( Errors )
+    {
+        qsort( pError, Errors, sizeof(double), _Host_CompareDouble );
+        printf( "HPS product error      : median %.2f%%, 95%% %.2f%%, max %.2f%% of %d bins\n",
+                100.0*pError[Errors/2], 100.0*pError[Errors*95/100], 100.0*pError[Errors-1], Errors );
+    }
+    if( Iterations>0 ) _Host_Benchmark( Host_Samples, Iterations );
+
+    free( pError );
+    free( Host_Samples );
+    return FeatureMismatch ? 1 : 0;
+}
+
+/* *****************************************************************************
+ End of File
+ */
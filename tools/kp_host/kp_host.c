@@ -0,0 +1,190 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    kp_host.c
+
+  @Summary
+    Host runner of the knowledge pack reference on recorded ECG samples.
+
+  @Description
+    Cuts a recording of BMD101 samples into windows, classifies each window
+    with KP_Host.c and prints the same result line as the target console.
+    The classes can be compared with a console log of the target on the
+    same recording.
+
+    kp_host [-s hop] [-c devicelog] [-f] [-n iterations] samples
+      -s : samples between window starts (default one window, 624 for the
+           50% overlap of SML_CONTINUOUS_ENABLE)
+      -c : compare the Classification of each window with the result lines
+           of devicelog, in order, exit 1 on mismatch
+      -f : print the scaled feature vector and nearest pattern of each window
+      -n : benchmark iterations of one window, 0 to skip (default 0)
+ */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "KP_Host.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: File Scope or Global Data                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#define HOST_LINE_SIZE 512
+
+int16_t *Host_Samples = NULL;
+int Host_Count = 0;
+int Host_Classes[KP_CLASSES];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+static double _Host_Now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec*1e9+ts.tv_nsec;
+}
+
+// Next Classification of a target result line, -1 at end of log
+static int _Host_DeviceClass( FILE *pLog )
+{
+    char Line[HOST_LINE_SIZE];
+    const char *pClass;
+
+    while( fgets( Line, sizeof(Line), pLog ) )
+    {
+        pClass = strstr( Line, "\"Classification\":" );
+        if( pClass ) return atoi( pClass+strlen( "\"Classification\":" ) );
+    }
+    return -1;
+}
+
+static const char *_Host_ClassName( int Class )
+{
+    return ( Class>=0 && Class<KP_CLASSES ) ? KP_ClassName[Class] : "?";
+}
+
+static void _Host_Benchmark( int iterations )
+{
+    KP_HOST_RESULT Result;
+    double Start;
+    int i;
+
+    Start = _Host_Now();
+    for( i=0 ; i<iterations ; i++ ) KP_Host_Run( Host_Samples, &Result );
+    printf( "Window inference          : %9.1f ns\n", ( _Host_Now()-Start )/iterations );
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main Entry Point
+// *****************************************************************************
+// *****************************************************************************
+int main( int argc, char *argv[] )
+{
+    KP_HOST_RESULT Result;
+    char Line[HOST_LINE_SIZE];
+    const char *pDevLog = NULL;
+    FILE *pLog = NULL;
+    int Hop = KP_WINDOW_SIZE;
+    int Iterations = 0;
+    int Features = 0;
+    int Windows = 0, Mismatch = 0;
+    int Opt, Start, Device, i;
+
+    while( ( Opt = getopt( argc, argv, "s:c:fn:" ) )!=-1 )
+    {
+        switch( Opt )
+        {
+            case 's': Hop        = atoi( optarg ); break;
+            case 'c': pDevLog    = optarg; break;
+            case 'f': Features   = 1; break;
+            case 'n': Iterations = atoi( optarg ); break;
+            default:
+                fprintf( stderr, "usage: %s [-s hop] [-c devicelog] [-f] [-n iterations] samples\n", argv[0] );
+                return 2;
+        }
+    }
+    if( optind>=argc || Hop<=0 )
+    {
+        fprintf( stderr, "usage: %s [-s hop] [-c devicelog] [-f] [-n iterations] samples\n", argv[0] );
+        return 2;
+    }
+    Host_Count = KP_Host_Load( argv[optind], &Host_Samples );
+    if( Host_Count<0 )
+    {
+        perror( argv[optind] );
+        return 2;
+    }
+    if( Host_Count<KP_WINDOW_SIZE )
+    {
+        fprintf( stderr, "%s: %d samples, a window is %d\n", argv[optind], Host_Count, KP_WINDOW_SIZE );
+        return 2;
+    }
+    if( pDevLog && ( pLog = fopen( pDevLog, "r" ) )==NULL )
+    {
+        perror( pDevLog );
+        return 2;
+    }
+
+    for( Start=0 ; Start+KP_WINDOW_SIZE<=Host_Count ; Start+=Hop )
+    {
+        KP_Host_Run( &Host_Samples[Start], &Result );
+        KP_Host_Sprint( &Result, Line, sizeof(Line) );
+        printf( "%s\n", Line );
+        Host_Classes[Result.Class]++;
+        Windows++;
+
+        if( Features )
+        {
+            printf( "Window %d features:", Windows );
+            for( i=0 ; i<KP_FEATURES ; i++ ) printf( " %u", Result.Features[i] );
+            printf( ", pattern %u distance %u\n", Result.Pattern, Result.Distance );
+        }
+        if( pLog )
+        {
+            Device = _Host_DeviceClass( pLog );
+            if( Device!=Result.Class )
+            {
+                printf( "Window %d (samples %d..%d): host %s, device %s\n", Windows, Start, Start+KP_WINDOW_SIZE-1,
+                        _Host_ClassName( Result.Class ), Device<0 ? "no result" : _Host_ClassName( Device ) );
+                Mismatch++;
+            }
+        }
+    }
+
+    printf( "%d windows:", Windows );
+    for( i=0 ; i<KP_CLASSES ; i++ ) printf( " %s %d", KP_ClassName[i], Host_Classes[i] );
+    printf( "\n" );
+    if( pLog )
+    {
+        if( _Host_DeviceClass( pLog )>=0 )
+        {
+            printf( "Device log has results after window %d\n", Windows );
+            Mismatch++;
+        }
+        printf( "Device comparison: %d mismatch\n", Mismatch );
+        fclose( pLog );
+    }
+
+    if( Iterations > 0 ) _Host_Benchmark( Iterations );
+
+    free( Host_Samples );
+    return Mismatch ? 1 : 0;
+}
+
+/* *****************************************************************************
+ End of File
+ */
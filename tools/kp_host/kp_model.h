@@ -0,0 +1,57 @@
+// Generated by kp_model.py from model.json, do not edit
+// Model TEST_1_RANK_0, uuid 43350e73-bd44-4a53-92ff-0a3e8fd92ff4
+#ifndef _KP_MODEL_H
+#define _KP_MODEL_H
+
+#define KP_WINDOW_SIZE    1248
+#define KP_HPS_HARMONICS  5
+#define KP_HPS_BLOCK      51   // HPS bins per block, 256/harmonics
+#define KP_POWER_BINS     16
+#define KP_HPS_OFFSET     0   // Generator outputs in the feature bank
+#define KP_PEAK_OFFSET    102
+#define KP_POWER_OFFSET   104
+#define KP_BANK_WRITTEN   120  // Slots the generators write
+#define KP_BANK_SIZE      69   // Slots the library allocates, min_max_scale reads modulo this
+#define KP_FEATURES       24
+#define KP_SCALE_MIN      0.0f
+#define KP_SCALE_MAX      255.0f
+#define KP_PATTERNS       4
+#define KP_CLASSES        3
+
+// Feature bank index of each feature, in feature vector order
+static const uint16_t KP_FeatureIndex[KP_FEATURES] = {
+    14, 58, 60, 67, 69, 70, 71, 75, 77, 80, 81, 85,
+    86, 90, 96, 98, 100, 103, 108, 110, 111, 115, 118, 119
+};
+
+static const float KP_FeatureMin[KP_FEATURES] = {
+    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f
+};
+
+static const float KP_FeatureMax[KP_FEATURES] = {
+    2.32173627e+12f, 6.35159561e+13f, 2.35593112e+12f, 6.85986873e+11f, 3.93087844e+11f, 4.68200161e+11f,
+    5.5960961e+11f, 1.44916152e+11f, 1.07144806e+11f, 9.97673042e+10f, 1.17005451e+11f, 4.95621939e+10f,
+    7.77838428e+10f, 2.7936895e+10f, 2.03637187e+10f, 4.92846817e+10f, 1.2493441e+10f, 2.12534054e+09f,
+    29.9950962f, 21.1246128f, 20.0666904f, 14.4142132f, 21.3847733f, 23.0350552f
+};
+
+static const uint8_t KP_Pattern[KP_PATTERNS][KP_FEATURES] = {
+    {  44,   2,  26,  34,   6,  10,  10,  59, 231, 167, 226, 132, 255, 103,   4, 255, 114, 248,   0,  12,  28,   0,  47,  48 },
+    {   0,   0,   1,   2,  35,   4,   4,  11, 104,   1,   4,  50,   1, 171, 135,  28,  16, 245,  82,  80, 110,  88,  57,  75 },
+    {   1,   0,   0,   0,   1,   1,   1,   9,   3,   4,   3,   8,  13,  14,  96,   4,  10, 252,  44,  73,  77,  35,  38,  95 },
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0 }
+};
+
+static const uint16_t KP_PatternCategory[KP_PATTERNS] = { 2, 2, 1, 2 };
+static const uint16_t KP_PatternAIF[KP_PATTERNS] = { 150, 150, 150, 150 };
+
+static const char *const KP_ClassName[KP_CLASSES] = {
+    "Unknown",
+    "AFib",
+    "Normal"
+};
+
+#endif /* _KP_MODEL_H */
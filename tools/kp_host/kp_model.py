@@ -0,0 +1,273 @@
+#!/usr/bin/env python3
+#
+#  kp_model.py
+#
+#  Generates kp_model.h, the constant tables of KP_Host.c, from the knowledge
+#  pack model.json:
+#
+#    python3 tools/kp_host/kp_model.py src/firmware/model.json tools/kp_host/kp_model.h \
+#        src/firmware/application/sml_fixed_model.h
+#
+#  Feature bank indices follow the layout the knowledge pack library writes:
+#  the generators of the generator set are stored one after the other, each
+#  taking the output count its library function returns. Harmonic Product
+#  Spectrum returns two blocks of 256/harmonic_coefficients bins (feature
+#  names gen_N and gen_N+1), Peak Harmonic Product Spectrum the peak index and
+#  value, Power Spectrum number_of_bins sums. The library only allocates one
+#  HPS block for the bank, which is the modulo min_max_scale reads it with.
+#
+#  The optional third file is sml_fixed_model.h of the target's fixed point
+#  feature path, sml_fixed_features.c. Through that modulo every feature reads
+#  an HPS bin or a slot no generator writes, so it only needs the HPS bin and
+#  the Min Max Scale maximum of each feature.
+#
+#  The optional fourth file is the model parameter blob of sml_blob.c as one
+#  line of hex, sent to the target with the 'u' console key: the Min Max Scale
+#  maxima and the PME patterns of this model.json. The feature bins stay built
+#  into the target, so the blob only loads on a target whose sml_fixed_model.h
+#  has the same bins and harmonics.
+#
+
+import binascii
+import json
+import re
+import struct
+import sys
+import zlib
+
+HPS = 'Harmonic Product Spectrum'
+PEAK_HPS = 'Peak Harmonic Product Spectrum'
+POWER = 'Power Spectrum'
+FFT_BINS = 256  # complex bins of the 512 point real FFT
+BLOB_MAGIC = 0x424C4D53  # "SMLB", sml_blob.h
+BLOB_VERSION = 1
+
+
+def f32(x):
+    return struct.unpack('<f', struct.pack('<f', x))[0]
+
+
+def c_float(x):
+    s = '%.9g' % f32(x)
+    if 'e' not in s and '.' not in s:
+        s += '.0'
+    return s + 'f'
+
+
+def step(model, name):
+    for s in model['knowledgepack_summary']:
+        if s['name'] == name:
+            return s
+    sys.exit('model.json: no %s step' % name)
+
+
+def generators(model):
+    gens = []
+    offset = 0
+    for g in step(model, 'generator_set')['set']:
+        fn = g['function_name']
+        if fn == HPS:
+            block = FFT_BINS // g['inputs']['harmonic_coefficients']
+            width, alloc = 2 * block, block
+        elif fn == PEAK_HPS:
+            block = width = alloc = 2
+        elif fn == POWER:
+            block = width = alloc = g['inputs']['number_of_bins']
+        else:
+            sys.exit('model.json: %s is not supported' % fn)
+        gens.append(dict(function=fn, inputs=g['inputs'], offset=offset, block=block, width=width, alloc=alloc))
+        offset += width
+    return gens
+
+
+def feature_index(gens, names, functions):
+    first = {}
+    index = []
+    for name, fn in zip(names, functions):
+        m = re.match(r'gen_(\d+)_.*_(\d+)$', name)
+        if not m:
+            sys.exit('model.json: feature %s' % name)
+        gen_id, out = int(m.group(1)), int(m.group(2))
+        g = next(g for g in gens if g['function'] == fn)
+        first.setdefault(fn, gen_id)
+        pos = (gen_id - first[fn]) * g['block'] + out
+        if pos >= g['width']:
+            sys.exit('model.json: feature %s outside of its generator' % name)
+        index.append(g['offset'] + pos)
+    return index
+
+
+def table(values, per_line, fmt):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(fmt(v) for v in values[i:i + per_line]))
+    return ',\n'.join(lines)
+
+
+def fixed_bins(gens, index, bank_size):
+    hps = next(g for g in gens if g['function'] == HPS)
+    bins = []
+    for idx in index:
+        slot = idx % bank_size
+        owner = [g for g in gens if g['offset'] <= slot < g['offset'] + g['width']]
+        if not owner:
+            bins.append(0)
+        elif owner[0] is hps and 0 < slot - hps['offset'] < hps['block']:
+            bins.append(slot - hps['offset'])
+        elif owner[0] is hps:
+            bins.append(0)  # slot 0 and the second block are never written
+        else:
+            sys.exit('model.json: feature slot %d is not an HPS bin, no fixed point path' % slot)
+    return bins
+
+
+def fixed_model(src, dst, desc, window, hps, index, bank_size, names, mm):
+    minmax = mm['feature_min_max_parameters']
+    if mm['min_bound'] != 0 or mm['max_bound'] != 255:
+        sys.exit('model.json: fixed point path needs Min Max Scale bounds 0..255')
+    if any(minmax['minimums'][n] != 0 for n in names) or any(minmax['maximums'][n] <= 0 for n in names):
+        sys.exit('model.json: fixed point path needs feature minimum 0 and maximum above 0')
+    bins = fixed_bins(generators(desc), index, bank_size)
+    harmonics = hps['inputs']['harmonic_coefficients']
+    mags = sorted({h * b for b in bins if b for h in range(1, harmonics)})
+    splits = [k for k in range(1, FFT_BINS // 2) if k in mags or FFT_BINS - k in mags]
+    mant, exp = [], []
+    for n in names:
+        bits = struct.unpack('<I', struct.pack('<f', minmax['maximums'][n]))[0]
+        if (bits >> 23) & 0xff == 0:
+            sys.exit('model.json: maximum of %s is denormal' % n)
+        mant.append((bits & 0x7fffff) | 0x800000)
+        exp.append(((bits >> 23) & 0xff) - 150)
+
+    out = []
+    out.append('//Generated by kp_model.py from %s, do not edit' % src.split('/')[-1])
+    out.append('//Model %s, uuid %s' % (desc['Name'], desc.get('uuid', '')))
+    out.append('#ifndef __SML_FIXED_MODEL_H__')
+    out.append('#define __SML_FIXED_MODEL_H__')
+    out.append('')
+    out.append('#define SML_FIXED_WINDOW    %d' % window)
+    out.append('#define SML_FIXED_HARMONICS %d' % harmonics)
+    out.append('#define SML_FIXED_FEATURES  %d' % len(names))
+    out.append('#define SML_FIXED_MAGNITUDES %d' % len(mags))
+    out.append('#define SML_FIXED_SPLITS    %d' % len(splits))
+    out.append('')
+    out.append('//HPS bin each feature reads through the feature bank, 0 for a slot that is never written')
+    out.append('static const uint8_t sml_fixed_bin[SML_FIXED_FEATURES] = {')
+    out.append(table(bins, 12, str))
+    out.append('};')
+    out.append('')
+    out.append('//FFT bins the HPS of those bins reads, harmonics 1..%d, ascending' % (harmonics - 1))
+    out.append('static const uint8_t sml_fixed_mag_bin[SML_FIXED_MAGNITUDES] = {')
+    out.append(table(mags, 16, str))
+    out.append('};')
+    out.append('')
+    out.append('//k of the real FFT split pairs (k, %d-k) holding them' % FFT_BINS)
+    out.append('static const uint8_t sml_fixed_split[SML_FIXED_SPLITS] = {')
+    out.append(table(splits, 16, str))
+    out.append('};')
+    out.append('')
+    out.append('//Min Max Scale maximum of each feature, mant*2^exp as the float in model.json')
+    out.append('static const uint32_t sml_fixed_max_mant[SML_FIXED_FEATURES] = {')
+    out.append(table(mant, 6, lambda v: '0x%06x' % v))
+    out.append('};')
+    out.append('static const int8_t sml_fixed_max_exp[SML_FIXED_FEATURES] = {')
+    out.append(table(exp, 12, str))
+    out.append('};')
+    out.append('')
+    out.append('#endif //__SML_FIXED_MODEL_H__')
+    open(dst, 'w').write('\n'.join(out) + '\n')
+    return bins, harmonics, mant, exp
+
+
+def blob(dst, desc, window, bins, harmonics, mant, exp):
+    # sml_blob_t: header, maxima, then category, influence and vector of each pattern
+    body = struct.pack('<%dI' % len(mant), *mant) + struct.pack('<%db' % len(exp), *exp)
+    for vec, cat, aif in zip(desc['Vector'], desc['Category'], desc['AIF']):
+        if len(vec) != len(mant):
+            sys.exit('model.json: pattern length %d' % len(vec))
+        body += struct.pack('<HH%dB' % len(vec), cat, aif, *vec)
+    layout = zlib.crc32(bytes(bins) + bytes([harmonics]))
+    uuid = bytes.fromhex(desc.get('uuid', '').replace('-', '')).ljust(16, b'\0')[:16]
+    size = 40 + len(body)
+    tail = struct.pack('<IHHHHI16s', size, BLOB_VERSION, len(mant), len(desc['Vector']), window, layout, uuid) + body
+    data = struct.pack('<II', BLOB_MAGIC, zlib.crc32(tail)) + tail
+    open(dst, 'w').write(binascii.hexlify(data).decode() + '\n')
+
+
+def main(src, dst, fixed=None, hexfile=None):
+    desc = json.load(open(src))['ModelDescriptions'][0]
+    window = step(desc, 'Windowing')['inputs']['window_size']
+    gens = generators(desc)
+    mm = step(desc, 'Min Max Scale')['inputs']
+    minmax = mm['feature_min_max_parameters']
+    names = list(minmax['maximums'].keys())
+    functions = desc['FeatureFunctions']
+    if len(names) != len(functions) or len(names) != len(desc['FeatureNames']):
+        sys.exit('model.json: feature count mismatch')
+    index = feature_index(gens, names, functions)
+    hps = next(g for g in gens if g['function'] == HPS)
+    peak = next(g for g in gens if g['function'] == PEAK_HPS)
+    power = next(g for g in gens if g['function'] == POWER)
+    if desc['ModelType'] != 'PME' or desc['DistanceMode'] != 0:
+        sys.exit('model.json: only PME with L1 distance is supported')
+    classes = desc['ClassMaps']
+    nclass = max(int(k) for k in classes) + 1
+    vectors = desc['Vector']
+
+    out = []
+    out.append('// Generated by kp_model.py from %s, do not edit' % src.split('/')[-1])
+    out.append('// Model %s, uuid %s' % (desc['Name'], desc.get('uuid', '')))
+    out.append('#ifndef _KP_MODEL_H')
+    out.append('#define _KP_MODEL_H')
+    out.append('')
+    out.append('#define KP_WINDOW_SIZE    %d' % window)
+    out.append('#define KP_HPS_HARMONICS  %d' % hps['inputs']['harmonic_coefficients'])
+    out.append('#define KP_HPS_BLOCK      %d   // HPS bins per block, 256/harmonics' % hps['block'])
+    out.append('#define KP_POWER_BINS     %d' % power['inputs']['number_of_bins'])
+    out.append('#define KP_HPS_OFFSET     %d   // Generator outputs in the feature bank' % hps['offset'])
+    out.append('#define KP_PEAK_OFFSET    %d' % peak['offset'])
+    out.append('#define KP_POWER_OFFSET   %d' % power['offset'])
+    out.append('#define KP_BANK_WRITTEN   %d  // Slots the generators write' % sum(g['width'] for g in gens))
+    out.append('#define KP_BANK_SIZE      %d   // Slots the library allocates, min_max_scale reads modulo this' % sum(g['alloc'] for g in gens))
+    out.append('#define KP_FEATURES       %d' % len(names))
+    out.append('#define KP_SCALE_MIN      %s' % c_float(mm['min_bound']))
+    out.append('#define KP_SCALE_MAX      %s' % c_float(mm['max_bound']))
+    out.append('#define KP_PATTERNS       %d' % len(vectors))
+    out.append('#define KP_CLASSES        %d' % nclass)
+    out.append('')
+    out.append('// Feature bank index of each feature, in feature vector order')
+    out.append('static const uint16_t KP_FeatureIndex[KP_FEATURES] = {')
+    out.append(table(index, 12, str))
+    out.append('};')
+    out.append('')
+    out.append('static const float KP_FeatureMin[KP_FEATURES] = {')
+    out.append(table([minmax['minimums'][n] for n in names], 6, c_float))
+    out.append('};')
+    out.append('')
+    out.append('static const float KP_FeatureMax[KP_FEATURES] = {')
+    out.append(table([minmax['maximums'][n] for n in names], 6, c_float))
+    out.append('};')
+    out.append('')
+    out.append('static const uint8_t KP_Pattern[KP_PATTERNS][KP_FEATURES] = {')
+    out.append(',\n'.join('    { ' + ', '.join('%3d' % v for v in vec) + ' }' for vec in vectors))
+    out.append('};')
+    out.append('')
+    out.append('static const uint16_t KP_PatternCategory[KP_PATTERNS] = { %s };' % ', '.join(str(c) for c in desc['Category']))
+    out.append('static const uint16_t KP_PatternAIF[KP_PATTERNS] = { %s };' % ', '.join(str(a) for a in desc['AIF']))
+    out.append('')
+    out.append('static const char *const KP_ClassName[KP_CLASSES] = {')
+    out.append(',\n'.join('    "%s"' % classes.get(str(i), '') for i in range(nclass)))
+    out.append('};')
+    out.append('')
+    out.append('#endif /* _KP_MODEL_H */')
+    open(dst, 'w').write('\n'.join(out) + '\n')
+    if fixed:
+        params = fixed_model(src, fixed, desc, window, hps, index, sum(g['alloc'] for g in gens), names, mm)
+        if hexfile:
+            blob(hexfile, desc, window, *params)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) not in (3, 4, 5):
+        sys.exit('usage: kp_model.py model.json kp_model.h [sml_fixed_model.h [model.hex]]')
+    main(*sys.argv[1:])
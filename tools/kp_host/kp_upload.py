@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+#
+#  kp_upload.py
+#
+#  Sends a model blob of kp_model.py to the target over the console UART,
+#  paced by the target:
+#
+#    stty -F /dev/ttyACM0 115200 raw
+#    python3 tools/kp_host/kp_upload.py /dev/ttyACM0 model.hex
+#
+#  The 'u' key starts the upload and the target answers "Page 0". After each
+#  flash page of the blob it has written, it prints "Page N". The script sends
+#  one page of hex (128 digits) after each Page line, so no byte arrives while
+#  the CPU is stalled on a flash write, then a newline, and prints the
+#  target's answer. An empty model.hex commits the built-in model again.
+#
+
+import os
+import re
+import select
+import sys
+import time
+
+PAGE_DIGITS = 128  # 2 hex digits a byte, NVMCTRL_FLASH_PAGESIZE 64
+TIMEOUT = 5.0
+PAGE_LINE = re.compile(rb'^Page (\d+)\r?$')
+DONE_LINE = re.compile(rb'^(Model blob|Built-in model|Upload aborted|Model slot)')
+
+
+def lines(fd):
+    data = b''
+    end = time.time() + TIMEOUT
+    while True:
+        left = end - time.time()
+        if left <= 0 or not select.select([fd], [], [], left)[0]:
+            sys.exit('no answer from the target')
+        data += os.read(fd, 256)
+        while b'\n' in data:
+            line, data = data.split(b'\n', 1)
+            yield line.rstrip(b'\r')
+            end = time.time() + TIMEOUT
+
+
+def main(device, hexfile):
+    digits = re.sub(r'\s', '', open(hexfile).read())
+    fd = os.open(device, os.O_RDWR | os.O_NOCTTY)
+    answer = lines(fd)
+
+    os.write(fd, b'u')
+    sent = 0
+    for line in answer:
+        if DONE_LINE.match(line):
+            print(file=sys.stderr)
+            print(line.decode('latin-1'))
+            if not line.startswith(b'Model blob v') and not line.startswith(b'Built-in model'):
+                sys.exit(1)
+            return
+        m = PAGE_LINE.match(line)
+        if not m:
+            continue
+        if int(m.group(1)) * PAGE_DIGITS != sent:
+            sys.exit('target at page %s, %d digits sent' % (m.group(1).decode(), sent))
+        chunk = digits[sent:sent + PAGE_DIGITS]
+        sent += len(chunk)
+        # A full page is acknowledged, the rest ends the blob
+        os.write(fd, chunk.encode() + (b'' if len(chunk) == PAGE_DIGITS else b'\n'))
+        print('\r%d of %d digits' % (sent, len(digits)), end='', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        sys.exit('usage: kp_upload.py device model.hex')
+    main(sys.argv[1], sys.argv[2])
@@ -0,0 +1,334 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    LCM_Host.c
+
+  @Summary
+    Host LCM backend, SSD1306 emulation into a 128x64 image.
+
+  @Description
+    Command bytes update the emulated SSD1306 registers, Data bytes go to
+    GDDRAM through the address pointers of the selected addressing mode.
+    Content scroll (2Ch/2Dh) moves GDDRAM by one Column. The visible image
+    applies start line, display offset, remap, inverse and display on/off
+    on top of GDDRAM.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdio.h>
+#include <string.h>
+#include "LCM_Host.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: File Scope or Global Data                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#define SSD1306_PAGES    (LCM_HEIGHT/8)
+#define SSD1306_CMD_ARGS 6   // Longest Command argument list (scroll setup)
+
+// Module is mounted for Segment remap (A1) and COM remapped scan (C8),
+// the other settings show the image mirrored like on the real glass
+#define HOST_MOUNT_SEG_REMAP 1
+#define HOST_MOUNT_COM_REMAP 1
+
+enum {
+    SSD1306_ADDR_HORIZONTAL = 0,
+    SSD1306_ADDR_VERTICAL,
+    SSD1306_ADDR_PAGE
+};
+
+struct {
+    uint8_t Ram[SSD1306_PAGES][LCM_WIDTH];  // GDDRAM
+
+    uint8_t AddrMode;
+    uint8_t ColStart, ColEnd, Col;
+    uint8_t PageStart, PageEnd, Page;
+    uint8_t StartLine;
+    uint8_t Offset;
+    uint8_t SegRemap;
+    uint8_t ComRemap;
+    uint8_t Inverse;
+    uint8_t EntireOn;
+    uint8_t DisplayOn;
+    uint8_t ScrollOn;                       // Continuous scroll activated (2Fh)
+
+    uint8_t Cmd[1+SSD1306_CMD_ARGS];        // Command being collected
+    uint8_t CmdLen, CmdNeed;
+} Host_SSD1306;
+
+LCM_HOST_STATS Host_Stats;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Local Functions
+// *****************************************************************************
+// *****************************************************************************
+// Argument count of the Command byte
+static uint8_t _Host_CmdArgs( uint8_t cmd )
+{
+    switch( cmd )
+    {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27: case 0x2C: case 0x2D:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+// One Column content scroll (2Ch right, 2Dh left) of GDDRAM Pages and Columns, wraps around
+static void _Host_ContentScroll( bool left, uint8_t p0, uint8_t p1, uint8_t c0, uint8_t c1 )
+{
+    uint8_t *pRow, Wrap;
+
+    if( c0 >= c1 ) return;
+    for( uint8_t Page=p0 ; Page<=p1 && Page<SSD1306_PAGES ; Page++ )
+    {
+        pRow = Host_SSD1306.Ram[Page];
+        if( left )
+        {
+            Wrap = pRow[c0];
+            memmove( &pRow[c0], &pRow[c0+1], c1-c0 );
+            pRow[c1] = Wrap;
+        }
+        else
+        {
+            Wrap = pRow[c1];
+            memmove( &pRow[c0+1], &pRow[c0], c1-c0 );
+            pRow[c0] = Wrap;
+        }
+    }
+}
+
+static void _Host_Execute( const uint8_t *pCmd )
+{
+    uint8_t Cmd = pCmd[0];
+
+    if( Cmd <= 0x0F )
+    {
+        // Page addressing lower Column nibble
+        Host_SSD1306.Col = (Host_SSD1306.Col&0xF0)|(Cmd&0x0F);
+    }
+    else if( Cmd <= 0x1F )
+    {
+        // Page addressing higher Column nibble
+        Host_SSD1306.Col = ((Cmd&0x07)<<4)|(Host_SSD1306.Col&0x0F);
+    }
+    else if( Cmd >= 0x40 && Cmd <= 0x7F )
+    {
+        Host_SSD1306.StartLine = Cmd&0x3F;
+    }
+    else if( Cmd >= 0xB0 && Cmd <= 0xB7 )
+    {
+        Host_SSD1306.Page = Cmd&0x07;
+    }
+    else switch( Cmd )
+    {
+        case 0x20: Host_SSD1306.AddrMode = pCmd[1]&0x03; break;
+        case 0x21:
+            Host_SSD1306.ColStart = pCmd[1]&0x7F;
+            Host_SSD1306.ColEnd   = pCmd[2]&0x7F;
+            Host_SSD1306.Col      = Host_SSD1306.ColStart;
+            break;
+        case 0x22:
+            Host_SSD1306.PageStart = pCmd[1]&0x07;
+            Host_SSD1306.PageEnd   = pCmd[2]&0x07;
+            Host_SSD1306.Page      = Host_SSD1306.PageStart;
+            break;
+        case 0x2C: case 0x2D:
+            // Content scroll, GDDRAM moves at once
+            _Host_ContentScroll( Cmd==0x2D, pCmd[2]&0x07, pCmd[4]&0x07, pCmd[5]&0x7F, pCmd[6]&0x7F );
+            break;
+        case 0x2E: Host_SSD1306.ScrollOn = 0; break;
+        case 0x2F:
+            // Continuous scroll runs on panel Frame timing, image keeps GDDRAM as is
+            Host_SSD1306.ScrollOn = 1;
+            printf( "LCM_Host: continuous scroll activated, not emulated\n" );
+            break;
+        case 0xD3: Host_SSD1306.Offset    = pCmd[1]&0x3F; break;
+        case 0xA0: case 0xA1: Host_SSD1306.SegRemap  = Cmd&0x01; break;
+        case 0xC0: case 0xC8: Host_SSD1306.ComRemap  = (Cmd>>3)&0x01; break;
+        case 0xA4: case 0xA5: Host_SSD1306.EntireOn  = Cmd&0x01; break;
+        case 0xA6: case 0xA7: Host_SSD1306.Inverse   = Cmd&0x01; break;
+        case 0xAE: case 0xAF: Host_SSD1306.DisplayOn = Cmd&0x01; break;
+        default:
+            // Timing, power and contrast settings do not change the image
+            break;
+    }
+}
+
+static void _Host_CommandByte( uint8_t byte )
+{
+    if( Host_SSD1306.CmdLen==0 )
+    {
+        Host_SSD1306.CmdNeed = 1+_Host_CmdArgs( byte );
+    }
+    Host_SSD1306.Cmd[Host_SSD1306.CmdLen++] = byte;
+
+    if( Host_SSD1306.CmdLen >= Host_SSD1306.CmdNeed )
+    {
+        _Host_Execute( Host_SSD1306.Cmd );
+        Host_SSD1306.CmdLen = 0;
+    }
+}
+
+static void _Host_DataByte( uint8_t byte )
+{
+    Host_SSD1306.Ram[Host_SSD1306.Page][Host_SSD1306.Col] = byte;
+
+    // Advance address pointers
+    switch( Host_SSD1306.AddrMode )
+    {
+        case SSD1306_ADDR_HORIZONTAL:
+            if( Host_SSD1306.Col >= Host_SSD1306.ColEnd )
+            {
+                Host_SSD1306.Col  = Host_SSD1306.ColStart;
+                Host_SSD1306.Page = ( Host_SSD1306.Page >= Host_SSD1306.PageEnd ) ? Host_SSD1306.PageStart : Host_SSD1306.Page+1;
+            }
+            else Host_SSD1306.Col++;
+            break;
+
+        case SSD1306_ADDR_VERTICAL:
+            if( Host_SSD1306.Page >= Host_SSD1306.PageEnd )
+            {
+                Host_SSD1306.Page = Host_SSD1306.PageStart;
+                Host_SSD1306.Col  = ( Host_SSD1306.Col >= Host_SSD1306.ColEnd ) ? Host_SSD1306.ColStart : Host_SSD1306.Col+1;
+            }
+            else Host_SSD1306.Page++;
+            break;
+
+        default:
+            // Page addressing, Column wraps inside the Page
+            Host_SSD1306.Col = ( Host_SSD1306.Col+1 )%LCM_WIDTH;
+            break;
+    }
+}
+
+static bool _Host_Init( void )
+{
+    LCM_Host_Reset();
+    return true;
+}
+
+static void _Host_Command( const uint8_t *pCmd, size_t size )
+{
+    Host_Stats.CmdBytes += size;
+    while( size-- ) _Host_CommandByte( *pCmd++ );
+}
+
+static bool _Host_Transfer( const uint8_t *pCmd, size_t cmdSize, const uint8_t *pData, size_t dataSize )
+{
+    _Host_Command( pCmd, cmdSize );
+
+    Host_Stats.DataBytes += dataSize;
+    Host_Stats.Transfers++;
+    while( dataSize-- ) _Host_DataByte( *pData++ );
+
+    return true;
+}
+
+static bool _Host_IsBusy( void )
+{
+    // Bytes are consumed at once
+    return false;
+}
+
+static bool _Host_Failed( void )
+{
+    // Emulated bus does not fail
+    return false;
+}
+
+const LCM_BACKEND LCM_Host_Backend = {
+    .Init     = _Host_Init,
+    .Command  = _Host_Command,
+    .Transfer = _Host_Transfer,
+    .IsBusy   = _Host_IsBusy,
+    .Failed   = _Host_Failed,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+void LCM_Host_Reset( void )
+{
+    // SSD1306 Power On Reset state
+    memset( &Host_SSD1306, 0, sizeof(Host_SSD1306) );
+    Host_SSD1306.AddrMode = SSD1306_ADDR_PAGE;
+    Host_SSD1306.ColEnd   = LCM_WIDTH-1;
+    Host_SSD1306.PageEnd  = SSD1306_PAGES-1;
+
+    LCM_Host_ClearStats();
+}
+
+bool LCM_Host_GetPixel( uint16_t x, uint16_t y )
+{
+    uint8_t Col, Row;
+
+    if( x>=LCM_WIDTH || y>=LCM_HEIGHT ) return false;
+    if( !Host_SSD1306.DisplayOn ) return false;
+    if(  Host_SSD1306.EntireOn  ) return true;
+
+    // Glass position to GDDRAM Column and Row
+    Col = ( Host_SSD1306.SegRemap==HOST_MOUNT_SEG_REMAP ) ? x : LCM_WIDTH-1-x;
+    Row = ( Host_SSD1306.ComRemap==HOST_MOUNT_COM_REMAP ) ? y : LCM_HEIGHT-1-y;
+    Row = ( Row+Host_SSD1306.StartLine+Host_SSD1306.Offset )%LCM_HEIGHT;
+
+    return ( (Host_SSD1306.Ram[Row/8][Col]>>(Row%8))&0x1 ) ^ Host_SSD1306.Inverse;
+}
+
+bool LCM_Host_DumpPBM( const char *path )
+{
+    FILE *pFile;
+    uint8_t Line[LCM_WIDTH/8];
+    uint16_t x, y;
+
+    pFile = fopen( path, "wb" );
+    if( pFile==NULL ) return false;
+
+    // Raw PBM, lit pixel as 1 (black)
+    fprintf( pFile, "P4\n%d %d\n", LCM_WIDTH, LCM_HEIGHT );
+    for( y=0 ; y<LCM_HEIGHT ; y++ )
+    {
+        memset( Line, 0, sizeof(Line) );
+        for( x=0 ; x<LCM_WIDTH ; x++ )
+        {
+            if( LCM_Host_GetPixel( x, y ) ) Line[x/8] |= 0x80>>(x%8);
+        }
+        fwrite( Line, 1, sizeof(Line), pFile );
+    }
+
+    return ( fclose( pFile )==0 );
+}
+
+void LCM_Host_GetStats( LCM_HOST_STATS *pStats )
+{
+    *pStats = Host_Stats;
+}
+
+void LCM_Host_ClearStats( void )
+{
+    memset( &Host_Stats, 0, sizeof(Host_Stats) );
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    LCM_Host.h
+
+  @Summary
+    Host LCM backend, SSD1306 emulation into a 128x64 image.
+
+  @Description
+    Interprets the SSD1306 Command/Data byte stream of LCM.c the way the
+    controller does, so the rendered image and the bytes on the bus can be
+    checked on the host.
+ */
+/* ************************************************************************** */
+
+#ifndef _LCM_HOST_H    /* Guard against multiple inclusion */
+#define _LCM_HOST_H
+
+#include "LCM.h"
+
+/* Provide C++ Compatibility */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Data Types
+    // *****************************************************************************
+    // *****************************************************************************
+typedef struct {
+    uint32_t CmdBytes;   // Bytes sent with RS low
+    uint32_t DataBytes;  // Bytes sent with RS high (GDDRAM)
+    uint32_t Transfers;  // Frame transfers (LCM_Update)
+} LCM_HOST_STATS;
+
+    // *****************************************************************************
+    // *****************************************************************************
+    // Section: Interface Functions
+    // *****************************************************************************
+    // *****************************************************************************
+extern const LCM_BACKEND LCM_Host_Backend;
+
+void LCM_Host_Reset( void );
+bool LCM_Host_GetPixel( uint16_t x, uint16_t y );
+bool LCM_Host_DumpPBM( const char *path );
+void LCM_Host_GetStats( LCM_HOST_STATS *pStats );
+void LCM_Host_ClearStats( void );
+
+    /* Provide C++ Compatibility */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LCM_HOST_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,41 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    definitions.h
+
+  @Summary
+    Host stand-in of the Harmony system definitions.
+
+  @Description
+    Found before src/config/default/definitions.h on the host include path,
+    gives LCM.c, GraphicLib.c and app_oled.c the few target symbols they use.
+ */
+/* ************************************************************************** */
+
+#ifndef _HOST_DEFINITIONS_H    /* Guard against multiple inclusion */
+#define _HOST_DEFINITIONS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Buttons released, LEDs ignored
+#define BT2_Get()     ( 1 )
+#define LED1_Set()
+#define LED1_Clear()
+
+// CPU clock of CPU_GetCycles(), host time scaled to it
+#define SYSTICK_FREQ 48000000U
+
+// No SysTick, stage latency probes compiled out
+#define APP_PROBE_ENABLE 0
+
+#endif /* _HOST_DEFINITIONS_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,363 @@
+/* ************************************************************************** */
+/** Descriptive File Name
+
+  @Company
+    Microchip
+
+  @File Name
+    oled_host.c
+
+  @Summary
+    Host runner of app_oled.c / GraphicLib.c / LCM.c on LCM_Host backend.
+
+  @Description
+    Renders the OLED screens of the application into PBM images, compares
+    them with reference images pixel by pixel and times the redraw paths.
+
+    oled_host [-o outdir] [-c refdir] [-n iterations]
+      -o : write <screen>.pbm into outdir
+      -c : compare every screen with refdir/<screen>.pbm, exit 1 on mismatch
+      -n : benchmark iterations, 0 to skip (default 10000)
+ */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "main.h"
+#include "app_oled.h"
+#include "app_ecg.h"
+#include "GraphicLib.h"
+#include "LCM_Host.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: File Scope or Global Data                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#define HOST_PATH_SIZE  256
+#define HOST_ECG_RATE   512   // BMD101 samples per second
+
+extern bool UI_Language;
+extern uint8_t LCM_FrameBuf[2][LCM_FRAME_SIZE];
+extern uint8_t LCM_BackIdx;
+
+const char *Host_OutDir = NULL;
+const char *Host_RefDir = NULL;
+int Host_Mismatch = 0;
+uint32_t Host_Tick = 0;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Target stand-ins used by app_oled.c
+// *****************************************************************************
+// *****************************************************************************
+void myprintf(const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void TC4_DelayMS( uint32_t ms, uint8_t idx )
+{
+    (void)ms;
+    (void)idx;
+}
+
+bool TC4_DelayIsComplete( uint8_t idx )
+{
+    // No waiting on host
+    (void)idx;
+    return true;
+}
+
+uint32_t TC4_GetTickCount( void )
+{
+    return Host_Tick;
+}
+
+uint32_t CPU_GetCycles( void )
+{
+    struct timespec ts;
+
+    // Host time in cycles of the 48MHz target clock
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (uint32_t)ts.tv_sec*48000000U + (uint32_t)(ts.tv_nsec/1000)*48U;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+static double _Host_Now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec*1e9 + ts.tv_nsec;
+}
+
+static bool _Host_LoadPBM( const char *path, uint8_t *pImage, size_t size )
+{
+    FILE *pFile;
+    int w, h;
+    bool ok = false;
+
+    pFile = fopen( path, "rb" );
+    if( pFile==NULL ) return false;
+
+    if( fscanf( pFile, "P4 %d %d", &w, &h )==2 && w==LCM_WIDTH && h==LCM_HEIGHT && fgetc( pFile )!=EOF )
+    {
+        ok = ( fread( pImage, 1, size, pFile )==size );
+    }
+    fclose( pFile );
+
+    return ok;
+}
+
+// Dump and/or compare the current screen
+static void _Host_Screen( const char *name )
+{
+    char Path[HOST_PATH_SIZE];
+    uint8_t Ref[LCM_WIDTH/8*LCM_HEIGHT];
+    int x, y, Diff = 0;
+
+    if( Host_OutDir )
+    {
+        snprintf( Path, sizeof(Path), "%s/%s.pbm", Host_OutDir, name );
+        if( !LCM_Host_DumpPBM( Path ) ) printf( "%-12s : cannot write %s\n", name, Path );
+    }
+
+    if( Host_RefDir )
+    {
+        snprintf( Path, sizeof(Path), "%s/%s.pbm", Host_RefDir, name );
+        if( !_Host_LoadPBM( Path, Ref, sizeof(Ref) ) )
+        {
+            printf( "%-12s : no reference %s\n", name, Path );
+            Host_Mismatch++;
+            return;
+        }
+
+        for( y=0 ; y<LCM_HEIGHT ; y++ )
+        {
+            for( x=0 ; x<LCM_WIDTH ; x++ )
+            {
+                if( LCM_Host_GetPixel( x, y )!=( (Ref[(y*LCM_WIDTH+x)/8]>>(7-(x%8)))&0x1 ) ) Diff++;
+            }
+        }
+
+        printf( "%-12s : %s (%d pixels differ)\n", name, Diff ? "MISMATCH" : "match", Diff );
+        if( Diff ) Host_Mismatch++;
+    }
+}
+
+// Panel image must equal the Front Frame Buffer after partial Windows and Scrolls
+static void _Host_Coherent( const char *name )
+{
+    const uint8_t *pFront = LCM_FrameBuf[LCM_BackIdx^1];
+    int x, y, Diff = 0;
+
+    for( y=0 ; y<LCM_HEIGHT ; y++ )
+    {
+        for( x=0 ; x<LCM_WIDTH ; x++ )
+        {
+            if( LCM_Host_GetPixel( x, y )!=( (pFront[x+(y/8)*LCM_WIDTH]>>(y%8))&0x1 ) ) Diff++;
+        }
+    }
+
+    printf( "%-12s : GDDRAM %s Frame Buffer (%d pixels differ)\n", name, Diff ? "MISMATCH" : "match", Diff );
+    if( Diff ) Host_Mismatch++;
+}
+
+// Synthetic ECG at 512Hz, one beat per second
+static int16_t _Host_ECG( int n )
+{
+    int Phase = n%HOST_ECG_RATE;
+
+    if( Phase>=400 && Phase<410 ) return 900;
+    if( Phase>=410 && Phase<420 ) return 100;
+    if( Phase>=600 && Phase<760 ) return 560;
+    return 500;
+}
+
+static void _Host_Wave( int samples )
+{
+    for( int n=0 ; n<samples ; n++ )
+    {
+        APP_OLED_ECG_WaveSample( _Host_ECG( n ) );
+    }
+}
+
+static void _Host_Screens( void )
+{
+    // Splash until the Logo stops
+    APP_OLED_Initialize();
+    while( APP_OLED_Get_State()!=APP_OLED_STATE_WAIT_SPLASH_COMPLETE )
+    {
+        APP_OLED_Tasks();
+    }
+    _Host_Screen( "splash" );
+
+    // Splash done, Screen clean
+    APP_OLED_Tasks();
+    _Host_Screen( "clean" );
+
+    UI_Language = UI_ENGLISH;
+    APP_OLED_ECG_Detect( 0 );
+    APP_OLED_Render();
+    _Host_Screen( "detect_en" );
+
+    // 128s of samples, every sweep level full
+    APP_OLED_ECG_HeartRate( 72 );
+    APP_OLED_ECG_FilterType( 4 );
+    _Host_Wave( 128*HOST_ECG_RATE );
+    APP_OLED_ML_Inference( "Normal" );
+    APP_OLED_Render();
+    _Host_Screen( "ecg_en" );
+
+    APP_OLED_ECG_WaveSweep( APP_OLED_SWEEP_8S );
+    APP_OLED_Render();
+    _Host_Screen( "sweep_8s" );
+    APP_OLED_ECG_WaveSweep( APP_OLED_SWEEP_32S );
+    APP_OLED_Render();
+    _Host_Screen( "sweep_32s" );
+    APP_OLED_ECG_WaveSweep( APP_OLED_SWEEP_128S );
+    APP_OLED_Render();
+    _Host_Screen( "sweep_128s" );
+    APP_OLED_ECG_WaveSweep( APP_OLED_SWEEP_2S );
+
+    UI_Language = UI_CHINESE;
+    APP_OLED_ECG_HeartRate( 105 );
+    APP_OLED_ML_Inference( "AFib" );
+    APP_OLED_Render();
+    _Host_Screen( "ecg_cn" );
+}
+
+// Render task on simulated TC4 ticks, wave samples at 512Hz
+static void _Host_Scheduler( void )
+{
+    APP_OLED_FRAME_STATS Stats;
+    uint32_t Start = Host_Tick;
+    int n = 0;
+
+    while( Host_Tick-Start < 100000 )
+    {
+        while( n < (int)((Host_Tick-Start)*HOST_ECG_RATE/10000) ) APP_OLED_ECG_WaveSample( _Host_ECG( n++ ) );
+
+        // 5s of normal load, then 5s with a 250ms stall every second
+        if( Host_Tick-Start >= 50000 && (Host_Tick-Start)%10000==0 ) Host_Tick += 2500;
+        APP_OLED_Tasks();
+        Host_Tick++;
+    }
+
+    APP_OLED_GetFrameStats( &Stats );
+    printf( "Render task (10s)         : %u Frames, %u skipped, last %u.%u FPS, render %u us (max %u us)\n",
+            Stats.Rendered, Stats.Skipped, Stats.Fps10/10, Stats.Fps10%10, Stats.RenderAvg, Stats.RenderMax );
+    _Host_Coherent( "scheduler" );
+}
+
+static void _Host_Benchmark( int iterations )
+{
+    LCM_HOST_STATS Stats, WaveStats;
+    double Start, HeartRate, Steady, Update, Sample, Wave, Sweep;
+    int i;
+
+    UI_Language = UI_ENGLISH;
+
+    Start = _Host_Now();
+    for( i=0 ; i<iterations ; i++ ) APP_OLED_ECG_HeartRate( 60+(i%100) );
+    HeartRate = ( _Host_Now()-Start )/iterations;
+
+    Start = _Host_Now();
+    for( i=0 ; i<iterations ; i++ ) APP_OLED_ECG_HeartRate( 72 );
+    Steady = ( _Host_Now()-Start )/iterations;
+
+    LCM_Host_ClearStats();
+    Start = _Host_Now();
+    for( i=0 ; i<iterations ; i++ )
+    {
+        APP_OLED_ECG_HeartRate( 60+(i%100) );
+        APP_OLED_Render();
+    }
+    Update = ( _Host_Now()-Start )/iterations;
+    LCM_Host_GetStats( &Stats );
+
+    Start = _Host_Now();
+    for( i=0 ; i<iterations*64 ; i++ ) APP_OLED_ECG_WaveSample( _Host_ECG( i ) );
+    Sample = ( _Host_Now()-Start )/(iterations*64);
+
+    // Samples of one Frame at OLED_FRAME_RATE
+    LCM_Host_ClearStats();
+    Start = _Host_Now();
+    for( i=0 ; i<iterations ; i++ )
+    {
+        _Host_Wave( HOST_ECG_RATE/OLED_FRAME_RATE );
+        APP_OLED_Render();
+    }
+    Wave = ( _Host_Now()-Start )/iterations;
+    LCM_Host_GetStats( &WaveStats );
+    _Host_Coherent( "wave" );
+
+    Start = _Host_Now();
+    for( i=0 ; i<iterations ; i++ )
+    {
+        APP_OLED_ECG_WaveSweep( (i%2) ? APP_OLED_SWEEP_2S : APP_OLED_SWEEP_32S );
+        APP_OLED_Render();
+    }
+    Sweep = ( _Host_Now()-Start )/iterations;
+
+    printf( "HeartRate redraw          : %9.1f ns\n", HeartRate );
+    printf( "HeartRate unchanged       : %9.1f ns\n", Steady );
+    printf( "HeartRate redraw + update : %9.1f ns\n", Update );
+    printf( "Wave sample (4 levels)    : %9.1f ns\n", Sample );
+    printf( "Wave Frame + update       : %9.1f ns\n", Wave );
+    printf( "Sweep switch + update     : %9.1f ns\n", Sweep );
+    printf( "HeartRate bytes per frame : %u command, %u data\n",
+            Stats.Transfers ? Stats.CmdBytes/Stats.Transfers : 0,
+            Stats.Transfers ? Stats.DataBytes/Stats.Transfers : 0 );
+    printf( "Wave bytes per frame      : %u command, %u data\n",
+            WaveStats.Transfers ? WaveStats.CmdBytes/WaveStats.Transfers : 0,
+            WaveStats.Transfers ? WaveStats.DataBytes/WaveStats.Transfers : 0 );
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main Entry Point
+// *****************************************************************************
+// *****************************************************************************
+int main( int argc, char *argv[] )
+{
+    int Iterations = 10000;
+    int Opt;
+
+    while( ( Opt = getopt( argc, argv, "o:c:n:" ) )!=-1 )
+    {
+        switch( Opt )
+        {
+            case 'o': Host_OutDir = optarg; break;
+            case 'c': Host_RefDir = optarg; break;
+            case 'n': Iterations  = atoi( optarg ); break;
+            default:
+                fprintf( stderr, "usage: %s [-o outdir] [-c refdir] [-n iterations]\n", argv[0] );
+                return 2;
+        }
+    }
+
+    _Host_Screens();
+    _Host_Scheduler();
+
+    if( Iterations > 0 ) _Host_Benchmark( Iterations );
+
+    return Host_Mismatch ? 1 : 0;
+}
+
+/* *****************************************************************************
+ End of File
+ */
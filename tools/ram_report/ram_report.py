@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+#
+#  ram_report.py
+#
+#  RAM map of a build from the XC32 linker map file:
+#
+#    python3 tools/ram_report/ram_report.py [--stack bytes] [--top n] \
+#        [--nm xc32-nm] LabX_ECG_AIML.X/dist/default/production
+#
+#  The argument is the map file or the directory holding it. The report lists
+#  the RAM of each owner (ECG, display, ML, system) from the map's memory usage
+#  by module, the largest RAM sections, the heap and the stack. The stack gets
+#  all RAM the sections and the heap leave, so its reservation is the headroom.
+#  With --stack, the stack the firmware needs is taken from it and the script
+#  exits with 1 when nothing is left.
+#
+#  The knowledge pack buffers the project's linker symbols bind to the
+#  storage of src/app_memory.c are checked on the ELF image next to the map:
+#  each must sit at its storage and be no larger, or the script exits with 1.
+#
+
+import argparse
+import glob
+import os
+import re
+import subprocess
+import sys
+
+# Owner of each module, first match on the "basename filename" of the map
+OWNERS = [
+    ('ECG', r'\bapp_ecg\.o'),
+    ('Display', r'\b(app_oled|GraphicLib|LCM|LCM_SSD1306)\.o'),
+    ('ML shared', r'\bapp_memory\.o'),
+    ('ML', r'\bsml_\w+\.o|libmplabml\.a'),
+    ('Console', r'plib_sercom5_usart\.o'),
+    ('Drivers', r'plib_\w+\.o'),
+    ('C library', r'\.a$'),
+    ('System', r''),
+]
+
+# Knowledge pack buffer and the app storage bound to it, src/app_memory.h
+SHARED = [
+    ('RAW_DATA_BUFFER_0', 'APP_MemoryWindows'),
+    ('sortedData', 'APP_MemoryScratch'),
+]
+
+
+def map_file(path):
+    if os.path.isdir(path):
+        maps = glob.glob(os.path.join(path, '*.map'))
+        if len(maps) != 1:
+            sys.exit('%s: %d map files' % (path, len(maps)))
+        path = maps[0]
+    return path
+
+
+def parse(path):
+    sections, reserved, modules = [], {}, []
+    ram_size = None
+    part = None
+    for line in open(path, errors='replace'):
+        if line.startswith('RAM Data-Memory Usage'):
+            part = 'ram'
+        elif line.startswith('Dynamic Data-Memory Reservation'):
+            part = 'dynamic'
+        elif 'Memory-Usage Report By Module' in line:
+            part = 'module'
+        elif line.strip() == '' and part == 'module' and modules:
+            part = None
+        elif part == 'ram':
+            m = re.match(r'(\.\S+)\s+0x[0-9a-f]+\s+0x[0-9a-f]+\s+(\d+)', line)
+            if m:
+                sections.append((m.group(1), int(m.group(2))))
+            m = re.search(r'Total RAM used\s*:.*of\s+(0x[0-9a-f]+)', line)
+            if m:
+                ram_size = int(m.group(1), 16)
+                part = None
+        elif part == 'dynamic':
+            m = re.match(r'(heap|stack)\s+0x[0-9a-f]+\s+0x[0-9a-f]+\s+(\d+)', line)
+            if m:
+                reserved[m.group(1)] = int(m.group(2))
+        elif part == 'module':
+            m = re.match(r'\s*(\d+)\s+(\d+)\s+(\d+)\s+\d+\s+[0-9a-f]+\s+(.+?)\s*$', line)
+            if m and not m.group(4).endswith('.elf'):  # the image total
+                modules.append((m.group(4), int(m.group(2)), int(m.group(3))))
+    if not sections or ram_size is None or 'stack' not in reserved:
+        sys.exit('%s: no XC32 RAM usage report' % path)
+    return sections, reserved, modules, ram_size
+
+
+def symbols(nm, image):
+    try:
+        out = subprocess.run([nm, '-S', image], capture_output=True, text=True, check=True).stdout
+    except (OSError, subprocess.CalledProcessError) as e:
+        sys.exit('%s: %s' % (nm, e))
+    syms = {}
+    for line in out.splitlines():
+        m = re.match(r'([0-9a-f]+)\s+([0-9a-f]+)\s+\w\s+(\S+)$', line)
+        if m:
+            syms[m.group(3)] = (int(m.group(1), 16), int(m.group(2), 16))
+    return syms
+
+
+def check_shared(nm, path):
+    images = glob.glob(os.path.join(os.path.dirname(path), '*.elf'))
+    if len(images) != 1:
+        sys.exit('%s: %d ELF images next to the map' % (os.path.dirname(path) or '.', len(images)))
+    syms = symbols(nm, images[0])
+    errors = 0
+    print('Shared storage')
+    for lib, app in SHARED:
+        if lib not in syms or app not in syms:
+            print('error: %s or %s missing from %s' % (lib, app, os.path.basename(images[0])))
+            errors += 1
+            continue
+        (lib_at, lib_size), (app_at, app_size) = syms[lib], syms[app]
+        print('  %-20s %6d in %-20s %6d' % (lib, lib_size, app, app_size))
+        if lib_at != app_at:
+            print('error: %s is not bound to %s, check the linker symbols' % (lib, app))
+            errors += 1
+        elif lib_size > app_size:
+            print('error: %s is %d bytes larger than %s' % (lib, lib_size - app_size, app))
+            errors += 1
+    print('')
+    return errors
+
+
+def owner(module):
+    for name, pattern in OWNERS:
+        if re.search(pattern, module):
+            return name
+
+
+def main():
+    ap = argparse.ArgumentParser(description='RAM map of an XC32 build')
+    ap.add_argument('map', help='map file or the directory holding it')
+    ap.add_argument('--stack', type=int, default=0, help='stack the firmware needs, bytes')
+    ap.add_argument('--top', type=int, default=12, help='largest RAM sections listed')
+    ap.add_argument('--nm', default='xc32-nm', help='nm of the toolchain, for the shared storage check')
+    args = ap.parse_args()
+
+    path = map_file(args.map)
+    sections, reserved, modules, ram_size = parse(path)
+    used = sum(size for _, size in sections)
+
+    print('RAM map of %s' % os.path.basename(path))
+    print('')
+    print('%-12s %8s %8s %8s' % ('Owner', 'data', 'bss', 'total'))
+    totals = {}
+    for module, data, bss in modules:
+        t = totals.setdefault(owner(module), [0, 0])
+        t[0] += data
+        t[1] += bss
+    for name, _ in OWNERS:
+        if name in totals and sum(totals[name]):
+            data, bss = totals[name]
+            print('%-12s %8d %8d %8d' % (name, data, bss, data + bss))
+    print('')
+    errors = check_shared(args.nm, path)
+    print('Largest RAM sections')
+    for name, size in sorted(sections, key=lambda s: -s[1])[:args.top]:
+        print('  %-28s %6d' % (name, size))
+    print('')
+    heap = reserved.get('heap', 0)
+    stack = reserved['stack']
+    print('Sections    %6d bytes' % used)
+    print('Heap        %6d bytes' % heap)
+    print('Stack       %6d bytes, the RAM left of %d' % (stack, ram_size))
+    if args.stack:
+        headroom = stack - args.stack
+        print('Headroom    %6d bytes over a %d byte stack' % (headroom, args.stack))
+        if headroom < 0:
+            print('error: RAM over budget by %d bytes' % -headroom)
+            return 1
+    return 1 if errors else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
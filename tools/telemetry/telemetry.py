@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+#
+#  telemetry.py
+#
+#  Console of the target with its binary records printed as text:
+#
+#    stty -F /dev/ttyACM0 115200 raw
+#    python3 tools/telemetry/telemetry.py /dev/ttyACM0 | tee console.log
+#
+#  The argument is the console UART device, a captured byte stream or - for
+#  stdin. Console text is passed through as it is. A record frame is 0x03, the
+#  payload length, the payload, the inverted byte sum of the payload and 0xFC
+#  (src/app_telemetry.h). A frame that does not check is passed through as
+#  text. Result records print the lines the target printed before them, so
+#  tools/kp_host/kp_host -c reads the output as a device log.
+#
+
+import argparse
+import os
+import struct
+import sys
+
+START = 0x03
+END = 0xFC
+RESULT = 0x01
+
+# APP_TELEMETRY_RESULT_RECORD, packed little endian
+RESULT_FORMAT = '<BBbbIIHHHBB'
+RESULT_SIZE = struct.calcsize(RESULT_FORMAT)
+
+CLASSES = {0: 'Unknown', 1: 'AFib', 2: 'Normal'}
+SOURCE_PME, SOURCE_BLOB, SOURCE_SCREEN = 0, 1, 2
+MODEL_NUMBER = 0  # SML_MODEL_INDEX
+
+
+class Decoder:
+    def __init__(self, out, features):
+        self.out = out
+        self.features = features
+        self.shown = None
+        self.data = bytearray()
+
+    def text(self, data):
+        self.out.write(data.decode('latin-1'))
+
+    def result(self, payload):
+        (_, source, cls, shown, tick, window, duty10, influence, distance,
+         pattern, count) = struct.unpack_from(RESULT_FORMAT, payload)
+        vector = payload[RESULT_SIZE:RESULT_SIZE + count]
+        w = self.out.write
+
+        w('Window %u at %u.%us: duty %u.%u%%%s\n' % (window, tick // 10000, (tick // 1000) % 10,
+          duty10 // 10, duty10 % 10, ', cannot keep up' if duty10 >= 1000 else ''))
+        if source == SOURCE_SCREEN:
+            w('{"ModelNumber":%u,"Classification":%d,"OutputSize":0,"OutputTensor":[],"Irregularity":%u}\n'
+              % (MODEL_NUMBER, cls, distance))
+        else:
+            w('{"ModelNumber":%u,"Classification":%d,"OutputSize":4,'
+              '"OutputTensor":[%u.000000,%d.000000,%u.000000,%u.000000]}\n'
+              % (MODEL_NUMBER, cls, pattern, cls, influence, distance))
+        if cls in (1, 2):
+            w('%s\n' % CLASSES[cls])
+        if self.features and vector:
+            w('Window %u features: %s, pattern %u distance %u%s\n' % (window, ' '.join(str(v) for v in vector),
+              pattern, distance, ' (model blob)' if source == SOURCE_BLOB else ''))
+        # Window 1 is the first after 'k', the vote starts over
+        if shown >= 0 and (window == 1 or shown != self.shown):
+            w('Vote: %s\n' % CLASSES.get(shown, str(shown)))
+        self.shown = shown
+
+    def frame(self, payload):
+        if payload[0] == RESULT and len(payload) >= RESULT_SIZE:
+            self.result(payload)
+        else:
+            self.out.write('Record type 0x%02X, %u bytes\n' % (payload[0], len(payload)))
+
+    def feed(self, chunk):
+        self.data += chunk
+        data = self.data
+        i = 0
+        while True:
+            s = data.find(START, i)
+            if s < 0:
+                self.text(data[i:])
+                i = len(data)
+                break
+            self.text(data[i:s])
+            i = s
+            if s + 2 > len(data) or s + 4 + data[s + 1] > len(data):
+                break  # rest of the frame not in yet
+            n = data[s + 1]
+            payload = bytes(data[s + 2:s + 2 + n])
+            check, end = data[s + 2 + n], data[s + 3 + n]
+            if n and end == END and check == (~sum(payload)) & 0xFF:
+                self.frame(payload)
+                i = s + 4 + n
+            else:
+                self.text(data[s:s + 1])
+                i = s + 1
+        del data[:i]
+        self.out.flush()
+
+    def close(self):
+        self.text(self.data)
+        self.out.flush()
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Target console with its binary records as text')
+    ap.add_argument('input', help='console UART device, captured stream or - for stdin')
+    ap.add_argument('-f', '--features', action='store_true', help='print the feature vector of each result')
+    args = ap.parse_args()
+
+    fd = sys.stdin.fileno() if args.input == '-' else os.open(args.input, os.O_RDONLY)
+    decoder = Decoder(sys.stdout, args.features)
+    try:
+        while True:
+            chunk = os.read(fd, 4096)
+            if not chunk:
+                break
+            decoder.feed(chunk)
+    except KeyboardInterrupt:
+        pass
+    decoder.close()
+
+
+if __name__ == '__main__':
+    main()